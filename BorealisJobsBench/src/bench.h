@@ -0,0 +1,39 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+namespace Borealis::Jobs::Bench
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    /// <summary>
+    /// Returns the elapsed time since the given point in time in milliseconds.
+    /// </summary>
+    inline double ElapsedMs(const Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /// <summary>
+    /// Prints a single result row in a uniform format.
+    /// </summary>
+    inline void PrintResult(const char* benchmark, const char* variant, const double milliseconds)
+    {
+        printf("%-28s %-32s %12.3f ms\n", benchmark, variant, milliseconds);
+    }
+
+    // ------------------ Benchmarks ------------------
+
+    void RunIoBenchmark();
+    void RunSyncBenchmark();
+    void RunSpinLockBenchmark();
+    void RunSerialBenchmark();
+    void RunBatchingBenchmark();
+    void RunCounterBenchmark();
+    void RunAlgorithmBenchmark();
+    void RunStealingBenchmark();
+    void RunLayoutBenchmark();
+    void RunCostModelBenchmark();
+    void RunShardedCounterBenchmark();
+    void RunPriorityBenchmark();
+}
@@ -0,0 +1,116 @@
+#include "bench.h"
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <string>
+
+#include "../../src/job-system.h"
+#include "../../src/job-algorithms.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    // 1B elements need about 12 GiB (input, reference copy and the temporary buffer of the sort)
+    static constexpr size_t ELEMENT_COUNTS[] = { 10'000'000, 100'000'000, 1'000'000'000 };
+
+    static void FillRandom(std::vector<unsigned int>& values)
+    {
+        std::mt19937 generator(42);
+
+        for (unsigned int& value : values)
+        {
+            value = generator();
+        }
+    }
+
+    /// <summary>
+    /// Times the given variant on a fresh copy of the input.
+    /// </summary>
+    template<typename Func>
+    static double RunVariant(const std::vector<unsigned int>& input, std::vector<unsigned int>& work, const Func& func)
+    {
+        std::copy(input.begin(), input.end(), work.begin());
+
+        const Clock::time_point start = Clock::now();
+        func(work);
+        return ElapsedMs(start);
+    }
+
+    static bool IsEven(const unsigned int value)
+    {
+        return (value & 1) == 0;
+    }
+
+    /// <summary>
+    /// The parallel algorithms compared to the serial standard algorithms and the parallel standard execution policy.
+    /// </summary>
+    void RunAlgorithmBenchmark()
+    {
+        InitializeJobSystem();
+
+        for (const size_t count : ELEMENT_COUNTS)
+        {
+            std::vector<unsigned int> input(count);
+            std::vector<unsigned int> work(count);
+            FillRandom(input);
+
+            const std::string sortName = "sort (" + std::to_string(count / 1000000) + "M)";
+            const std::string scanName = "inclusive scan (" + std::to_string(count / 1000000) + "M)";
+            const std::string partitionName = "stable partition (" + std::to_string(count / 1000000) + "M)";
+
+            PrintResult(sortName.c_str(), "std::sort", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                std::sort(values.begin(), values.end());
+            }));
+            PrintResult(sortName.c_str(), "std::sort (par)", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                std::sort(std::execution::par, values.begin(), values.end());
+            }));
+            PrintResult(sortName.c_str(), "ParallelSort", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                ParallelSort(values.begin(), values.end());
+            }));
+
+            PrintResult(scanName.c_str(), "std::inclusive_scan", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                std::inclusive_scan(values.begin(), values.end(), values.begin());
+            }));
+            PrintResult(scanName.c_str(), "std::inclusive_scan (par)", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                std::inclusive_scan(std::execution::par, values.begin(), values.end(), values.begin());
+            }));
+            PrintResult(scanName.c_str(), "ParallelInclusiveScan", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                ParallelInclusiveScan(values.begin(), values.end(), values.begin());
+            }));
+
+            PrintResult(partitionName.c_str(), "std::stable_partition", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                std::stable_partition(values.begin(), values.end(), &IsEven);
+            }));
+            PrintResult(partitionName.c_str(), "std::stable_partition (par)", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                std::stable_partition(std::execution::par, values.begin(), values.end(), &IsEven);
+            }));
+            PrintResult(partitionName.c_str(), "ParallelStablePartition", RunVariant(input, work, [](std::vector<unsigned int>& values)
+            {
+                ParallelStablePartition(values.begin(), values.end(), &IsEven);
+            }));
+        }
+
+        DeinitializeJobSystem();
+    }
+
+#else
+
+    void RunAlgorithmBenchmark()
+    {
+        printf("The algorithm benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
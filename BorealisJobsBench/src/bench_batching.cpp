@@ -0,0 +1,111 @@
+#include "bench.h"
+
+#include <vector>
+
+#include "../../src/job-system.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static double s_iterationsPerNs = 1.0;
+    static std::atomic<unsigned long long> s_sink = 0;
+
+    static unsigned long long Spin(const unsigned long long iterations)
+    {
+        unsigned long long value = iterations;
+        for (unsigned long long i = 0; i < iterations; ++i)
+        {
+            value = value * 6364136223846793005ull + 1442695040888963407ull;
+        }
+
+        return value;
+    }
+
+    /// <summary>
+    /// Measures how many spin iterations fit into a nanosecond on this machine.
+    /// </summary>
+    static void Calibrate()
+    {
+        static constexpr unsigned long long calibrationIterations = 50000000ull;
+
+        const Clock::time_point start = Clock::now();
+        s_sink += Spin(calibrationIterations);
+        const double elapsedNs = ElapsedMs(start) * 1000000.0;
+
+        s_iterationsPerNs = calibrationIterations / elapsedNs;
+    }
+
+    JobReturnType MicroJob(uintptr_t iterations)
+    {
+        s_sink.fetch_add(Spin(iterations) & 1, std::memory_order_relaxed);
+    }
+
+    static double RunVariant(const int maxBatchSize, const int jobCount, const unsigned long long iterations)
+    {
+        InitializeJobSystem();
+        SetMaxJobBatchSize(maxBatchSize);
+
+        std::vector<Job> jobs;
+        jobs.reserve(jobCount);
+
+        Counter counter = Counter(jobCount);
+        for (int i = 0; i < jobCount; ++i)
+        {
+            jobs.push_back(Job(&MicroJob, &counter, Priority::NORMAL, "MicroJob", (uintptr_t)iterations));
+        }
+
+        const Clock::time_point start = Clock::now();
+        KickJobs(jobs.data(), jobCount);
+        WaitForCounter(&counter);
+        const double elapsed = ElapsedMs(start);
+
+        SetMaxJobBatchSize(MAX_JOB_BATCH_SIZE());
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Throughput of micro-jobs between 100ns and 10us with and without batching.
+    /// </summary>
+    void RunBatchingBenchmark()
+    {
+        Calibrate();
+
+        struct Scenario
+        {
+            const char* m_Name;
+            double m_JobNs;
+            int m_JobCount;
+        };
+
+        const Scenario scenarios[] =
+        {
+            { "batching (100ns jobs)", 100.0, 400000 },
+            { "batching (1us jobs)", 1000.0, 200000 },
+            { "batching (10us jobs)", 10000.0, 40000 },
+        };
+
+        for (const Scenario& scenario : scenarios)
+        {
+            const unsigned long long iterations = (unsigned long long)(scenario.m_JobNs * s_iterationsPerNs);
+
+            const double unbatchedMs = RunVariant(1, scenario.m_JobCount, iterations);
+            const double batchedMs = RunVariant(MAX_JOB_BATCH_SIZE(), scenario.m_JobCount, iterations);
+
+            PrintResult(scenario.m_Name, "one job per grab", unbatchedMs);
+            PrintResult(scenario.m_Name, "adaptive batches", batchedMs);
+            printf("%-28s %-32s %12.2f Mjobs/s -> %.2f Mjobs/s\n", scenario.m_Name, "throughput",
+                scenario.m_JobCount / (unbatchedMs * 1000.0), scenario.m_JobCount / (batchedMs * 1000.0));
+        }
+    }
+
+#else
+
+    void RunBatchingBenchmark()
+    {
+        printf("The batching benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
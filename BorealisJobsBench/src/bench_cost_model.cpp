@@ -0,0 +1,73 @@
+#include "bench.h"
+
+#include <vector>
+
+#include "../../src/job-system.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_JOBS = 100000;
+
+    static unsigned long long s_costResults[NUM_JOBS] = {};
+
+    JobReturnType CostTinyJob(uintptr_t index)
+    {
+        s_costResults[index] = index * 6364136223846793005ull + 1442695040888963407ull;
+    }
+
+    static double RunTinyJobs(const bool inlineTinyJobs)
+    {
+        std::vector<Job> jobs;
+        jobs.reserve(NUM_JOBS);
+
+        Counter counter = Counter(NUM_JOBS);
+        for (int i = 0; i < NUM_JOBS; ++i)
+        {
+            jobs.push_back(Job(&CostTinyJob, &counter, Priority::NORMAL, "CostTinyJob", (uintptr_t)i));
+        }
+
+        const Clock::time_point start = Clock::now();
+
+        if (inlineTinyJobs)
+            KickOrInlineJobs(jobs.data(), NUM_JOBS);
+        else
+            KickJobs(jobs.data(), NUM_JOBS);
+
+        WaitForCounter(&counter);
+        return ElapsedMs(start);
+    }
+
+    /// <summary>
+    /// Tiny jobs kicked to the workers compared to KickOrInline running them on the calling fiber once their cost is known.
+    /// </summary>
+    void RunCostModelBenchmark()
+    {
+        InitializeJobSystem();
+        ResetJobCosts();
+
+        // Learns the cost of the job type
+        const double kickMs = RunTinyJobs(false);
+
+        double estimateNs = 0.0;
+        GetJobCostEstimate("CostTinyJob", estimateNs);
+        printf("Learned cost of CostTinyJob: %.1f ns\n", estimateNs);
+
+        const double inlineMs = RunTinyJobs(true);
+
+        DeinitializeJobSystem();
+
+        PrintResult("100k tiny jobs", "KickJobs", kickMs);
+        PrintResult("100k tiny jobs", "KickOrInlineJobs", inlineMs);
+    }
+
+#else
+
+    void RunCostModelBenchmark()
+    {
+        printf("The cost model benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
@@ -0,0 +1,90 @@
+#include "bench.h"
+
+#include "../../src/job-system.h"
+#include "../../src/counter-pool.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_FAN_OUTS = 20000;
+    static constexpr int FAN_OUT_WIDTH = 4;
+    static constexpr int NUM_PARENT_JOBS = 64;
+
+    JobReturnType EmptyChildJob(uintptr_t) { }
+
+    /// <summary>
+    /// Every parent job fans out to a few children and waits for them using a heap allocated counter.
+    /// </summary>
+    JobReturnType HeapCounterParentJob(uintptr_t)
+    {
+        for (int i = 0; i < NUM_FAN_OUTS / NUM_PARENT_JOBS; ++i)
+        {
+            Counter* counter = new Counter(FAN_OUT_WIDTH);
+
+            for (int c = 0; c < FAN_OUT_WIDTH; ++c)
+            {
+                KickJob(Job(&EmptyChildJob, counter, Priority::HIGH, "EmptyChildJob"));
+            }
+
+            WaitForCounterAndFree(counter);
+        }
+    }
+
+    /// <summary>
+    /// Same as above but with a pooled counter.
+    /// </summary>
+    JobReturnType PooledCounterParentJob(uintptr_t)
+    {
+        for (int i = 0; i < NUM_FAN_OUTS / NUM_PARENT_JOBS; ++i)
+        {
+            CounterHandle handle = AllocateCounter(FAN_OUT_WIDTH);
+
+            for (int c = 0; c < FAN_OUT_WIDTH; ++c)
+            {
+                KickJob(Job(&EmptyChildJob, GetCounter(handle), Priority::HIGH, "EmptyChildJob"));
+            }
+
+            WaitForCounterAndFree(handle);
+        }
+    }
+
+    static double RunVariant(const JobEntryPoint& parentJob)
+    {
+        InitializeJobSystem();
+
+        Counter counter = Counter(NUM_PARENT_JOBS);
+
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < NUM_PARENT_JOBS; ++i)
+        {
+            KickJob(Job(parentJob, &counter, Priority::NORMAL, "ParentJob"));
+        }
+        WaitForCounter(&counter);
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Fan-out / fan-in throughput with heap allocated counters compared to pooled counters.
+    /// </summary>
+    void RunCounterBenchmark()
+    {
+        const double heapMs = RunVariant(&HeapCounterParentJob);
+        const double pooledMs = RunVariant(&PooledCounterParentJob);
+
+        PrintResult("counters (20k fan-outs x 4)", "new / delete Counter", heapMs);
+        PrintResult("counters (20k fan-outs x 4)", "pooled CounterHandle", pooledMs);
+    }
+
+#else
+
+    void RunCounterBenchmark()
+    {
+        printf("The counter benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
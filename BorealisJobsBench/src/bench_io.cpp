@@ -0,0 +1,147 @@
+#include "bench.h"
+
+#include <vector>
+#include <string>
+#include <cstdio>
+
+#include "../../src/job-system.h"
+#include "../../src/job-io.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_FILES = 256;
+    static constexpr unsigned long FILE_SIZE = 256 * 1024;
+    static constexpr int COMPUTE_ROUNDS = 8;
+
+    static std::string GetFilePath(const int index)
+    {
+        return "borealis_io_bench_" + std::to_string(index) + ".bin";
+    }
+
+    /// <summary>
+    /// Some compute work on the read data so there is something to overlap the IO with.
+    /// </summary>
+    static unsigned long long Checksum(const std::vector<char>& data)
+    {
+        unsigned long long hash = 1469598103934665603ull;
+
+        for (int round = 0; round < COMPUTE_ROUNDS; ++round)
+        {
+            for (const char c : data)
+            {
+                hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+            }
+        }
+
+        return hash;
+    }
+
+    static void CreateFiles()
+    {
+        std::vector<char> data(FILE_SIZE);
+
+        for (int i = 0; i < NUM_FILES; ++i)
+        {
+            for (unsigned long b = 0; b < FILE_SIZE; ++b)
+            {
+                data[b] = (char)((b + i) % 253);
+            }
+
+            HANDLE file = CreateFileA(GetFilePath(i).c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            DWORD written = 0;
+            WriteFile(file, data.data(), FILE_SIZE, &written, NULL);
+            CloseHandle(file);
+        }
+    }
+
+    static void DeleteFiles()
+    {
+        for (int i = 0; i < NUM_FILES; ++i)
+        {
+            std::remove(GetFilePath(i).c_str());
+        }
+    }
+
+    static unsigned long long s_checksums[NUM_FILES] = {};
+
+    JobReturnType BlockingReadJob(uintptr_t index)
+    {
+        std::vector<char> data(FILE_SIZE);
+
+        HANDLE file = CreateFileA(GetFilePath((int)index).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        DWORD bytesRead = 0;
+        ReadFile(file, data.data(), FILE_SIZE, &bytesRead, NULL);
+        CloseHandle(file);
+
+        s_checksums[index] = Checksum(data);
+    }
+
+    JobReturnType AsyncReadJob(uintptr_t index)
+    {
+        std::vector<char> data(FILE_SIZE);
+
+        HANDLE file = OpenAsyncFile(GetFilePath((int)index).c_str());
+        AsyncRead(file, data.data(), FILE_SIZE);
+        CloseHandle(file);
+
+        s_checksums[index] = Checksum(data);
+    }
+
+    static double RunVariant(const JobEntryPoint& entryPoint)
+    {
+        InitializeJobSystem();
+
+        std::vector<Job> jobs;
+        jobs.reserve(NUM_FILES);
+
+        Counter counter = Counter(NUM_FILES);
+
+        for (int i = 0; i < NUM_FILES; ++i)
+        {
+            jobs.push_back(Job(entryPoint, &counter, Priority::NORMAL, "IoBenchJob", (uintptr_t)i));
+        }
+
+        const Clock::time_point start = Clock::now();
+        KickJobs(jobs.data(), NUM_FILES);
+        WaitForCounter(&counter);
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Reads many files concurrently from within jobs, once with blocking reads and once with fiber-aware async reads.
+    /// Note: The files are freshly written and therefore most likely served by the file cache. Flush the standby list
+    /// between the variants to measure actual disk latency.
+    /// </summary>
+    void RunIoBenchmark()
+    {
+        CreateFiles();
+
+        const double blockingMs = RunVariant(&BlockingReadJob);
+        const unsigned long long blockingChecksum = s_checksums[NUM_FILES - 1];
+
+        const double asyncMs = RunVariant(&AsyncReadJob);
+        const unsigned long long asyncChecksum = s_checksums[NUM_FILES - 1];
+
+        PrintResult("io (256 x 256 KiB)", "blocking ReadFile in jobs", blockingMs);
+        PrintResult("io (256 x 256 KiB)", "AsyncRead (fiber parked)", asyncMs);
+
+        if (blockingChecksum != asyncChecksum)
+            printf("WARNING: Checksums of both variants differ!\n");
+
+        DeleteFiles();
+    }
+
+#else
+
+    void RunIoBenchmark()
+    {
+        printf("The IO benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
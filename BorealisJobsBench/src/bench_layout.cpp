@@ -0,0 +1,131 @@
+#include "bench.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include "../../src/job-system.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_INCREMENTS = 10000000;
+
+    // Which scheduler layout the library was built with. Rebuild with BOREALIS_PACKED_SCHEDULER_LAYOUT to compare both.
+#ifdef BOREALIS_PACKED_SCHEDULER_LAYOUT
+    static constexpr const char* SCHEDULER_LAYOUT = "packed scheduler";
+#else
+    static constexpr const char* SCHEDULER_LAYOUT = "cache line aligned scheduler";
+#endif
+
+    struct PackedCounter
+    {
+        std::atomic<long long> m_Value = 0;
+    };
+
+    struct alignas(CACHE_LINE_SIZE()) PaddedCounter
+    {
+        std::atomic<long long> m_Value = 0;
+    };
+
+    /// <summary>
+    /// Every thread increments its own counter. Packed counters share cache lines, padded ones don't.
+    /// </summary>
+    template<typename CounterType>
+    static double RunCounters(const int threadCount)
+    {
+        std::vector<CounterType> counters(threadCount);
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+
+        const Clock::time_point start = Clock::now();
+
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&counters, t]()
+            {
+                for (int i = 0; i < NUM_INCREMENTS; ++i)
+                {
+                    counters[t].m_Value.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        return ElapsedMs(start);
+    }
+
+    static constexpr int NUM_PRODUCERS = 12;
+    static constexpr int JOBS_PER_PRODUCER = 20000;
+
+    JobReturnType LayoutTinyJob(uintptr_t)
+    {
+    }
+
+    /// <summary>
+    /// Producers spread over all priorities kick tiny jobs while the workers drain all queues, which stresses
+    /// the queue locks, the wait list and the flags polled by every worker at the same time.
+    /// </summary>
+    static double RunMixedPriorityKicks()
+    {
+        InitializeJobSystem();
+
+        Counter childCounter = Counter(NUM_PRODUCERS * JOBS_PER_PRODUCER);
+        Counter producerCounter = Counter(NUM_PRODUCERS);
+
+        auto producer = [&childCounter](uintptr_t index)
+        {
+            // LOW, NORMAL or HIGH
+            const Priority priority = (Priority)(index % 3);
+
+            for (int i = 0; i < JOBS_PER_PRODUCER; ++i)
+            {
+                KickJob(Job(&LayoutTinyJob, &childCounter, priority, "LayoutTinyJob"));
+            }
+        };
+
+        const Clock::time_point start = Clock::now();
+
+        for (int p = 0; p < NUM_PRODUCERS; ++p)
+        {
+            KickJob(Job(producer, &producerCounter, Priority::HIGH, "Producer", (uintptr_t)p));
+        }
+
+        WaitForCounter(&producerCounter);
+        WaitForCounter(&childCounter);
+
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// False sharing between per-thread data on the same cache line and the effect of the cache-line-aware scheduler
+    /// layout. The scheduler part is compared by running it once with and once without BOREALIS_PACKED_SCHEDULER_LAYOUT.
+    /// Run it under a cache-contention profiler (e.g. VTune's memory access analysis) to attribute the remaining contended lines.
+    /// </summary>
+    void RunLayoutBenchmark()
+    {
+        const int threadCount = std::max(2, (int)std::thread::hardware_concurrency());
+
+        PrintResult("own counter per thread", "packed", RunCounters<PackedCounter>(threadCount));
+        PrintResult("own counter per thread", "cache line aligned", RunCounters<PaddedCounter>(threadCount));
+        PrintResult("mixed priority kicks (240k)", SCHEDULER_LAYOUT, RunMixedPriorityKicks());
+    }
+
+#else
+
+    void RunLayoutBenchmark()
+    {
+        printf("The layout benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
@@ -0,0 +1,111 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "../../src/job-system.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_LOAD_JOBS = 40000;
+    // Without inheritance every request arriving during the backlog stays parked -> Stay well below NUM_FIBERS
+    static constexpr int NUM_REQUESTS = 100;
+    static constexpr int REQUEST_WIDTH = 4;
+
+    static void SpinFor(const std::chrono::microseconds duration)
+    {
+        const Clock::time_point start = Clock::now();
+        while (Clock::now() - start < duration) { }
+    }
+
+    JobReturnType BackgroundLoadJob(uintptr_t)
+    {
+        SpinFor(std::chrono::microseconds(20));
+    }
+
+    JobReturnType RequestChildJob(uintptr_t)
+    {
+        SpinFor(std::chrono::microseconds(5));
+    }
+
+    /// <summary>
+    /// Latency of high priority requests fanning out to low priority children while the workers are flooded with
+    /// normal priority jobs. Reports the median and the 99th percentile of the request latencies in milliseconds.
+    /// </summary>
+    static void RunMixedLoad(const bool priorityInheritance, double& p50Ms, double& p99Ms)
+    {
+        JobSchedulerDesc desc{};
+        desc.m_PriorityInheritance = priorityInheritance;
+
+        JobScheduler scheduler;
+        scheduler.Initialize(desc);
+
+        std::vector<Clock::time_point> kickTimes(NUM_REQUESTS);
+        std::vector<double> latencies(NUM_REQUESTS);
+
+        auto requestJob = [&](uintptr_t index)
+        {
+            Counter children = Counter(REQUEST_WIDTH);
+            for (int i = 0; i < REQUEST_WIDTH; ++i)
+            {
+                KickJob(Job(&RequestChildJob, &children, Priority::LOW, "RequestChildJob"));
+            }
+
+            WaitForCounter(&children);
+            latencies[index] = ElapsedMs(kickTimes[index]);
+        };
+
+        Counter loadCounter = Counter(NUM_LOAD_JOBS);
+        std::vector<Job> loadJobs(NUM_LOAD_JOBS, Job(&BackgroundLoadJob, &loadCounter, Priority::NORMAL, "BackgroundLoadJob"));
+        KickJobs(loadJobs.data(), NUM_LOAD_JOBS);
+
+        // Requests arrive while the normal priority backlog is drained
+        Counter requestCounter = Counter(NUM_REQUESTS);
+        for (int i = 0; i < NUM_REQUESTS; ++i)
+        {
+            kickTimes[i] = Clock::now();
+            KickJob(Job(requestJob, &requestCounter, Priority::HIGH, "RequestJob", (uintptr_t)i));
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        WaitForCounter(&requestCounter);
+        WaitForCounter(&loadCounter);
+
+        scheduler.Deinitialize();
+
+        std::sort(latencies.begin(), latencies.end());
+        p50Ms = latencies[NUM_REQUESTS / 2];
+        p99Ms = latencies[(NUM_REQUESTS * 99) / 100];
+    }
+
+    /// <summary>
+    /// Tail latency of high priority jobs waiting on low priority children under normal priority load,
+    /// with and without the waiters lending their priority to the children.
+    /// </summary>
+    void RunPriorityBenchmark()
+    {
+        double plainP50 = 0.0, plainP99 = 0.0;
+        double inheritedP50 = 0.0, inheritedP99 = 0.0;
+
+        RunMixedLoad(false, plainP50, plainP99);
+        RunMixedLoad(true, inheritedP50, inheritedP99);
+
+        PrintResult("request latency p50", "without priority inheritance", plainP50);
+        PrintResult("request latency p50", "with priority inheritance", inheritedP50);
+        PrintResult("request latency p99", "without priority inheritance", plainP99);
+        PrintResult("request latency p99", "with priority inheritance", inheritedP99);
+    }
+
+#else
+
+    void RunPriorityBenchmark()
+    {
+        printf("The priority benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
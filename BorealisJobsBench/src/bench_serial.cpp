@@ -0,0 +1,83 @@
+#include "bench.h"
+
+#include <vector>
+
+#include "../../src/job-system.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_JOBS = 200000;
+
+    static unsigned long long s_results[NUM_JOBS] = {};
+
+    JobReturnType TinyJob(uintptr_t index)
+    {
+        unsigned long long value = index;
+        for (int i = 0; i < 32; ++i)
+        {
+            value = value * 6364136223846793005ull + 1442695040888963407ull;
+        }
+
+        s_results[index] = value;
+    }
+
+    static double RunJobSystem(const int numOfThreads)
+    {
+        InitializeJobSystem(numOfThreads);
+
+        std::vector<Job> jobs;
+        jobs.reserve(NUM_JOBS);
+
+        Counter counter = Counter(NUM_JOBS);
+        for (int i = 0; i < NUM_JOBS; ++i)
+        {
+            jobs.push_back(Job(&TinyJob, &counter, Priority::NORMAL, "TinyJob", (uintptr_t)i));
+        }
+
+        const Clock::time_point start = Clock::now();
+        KickJobs(jobs.data(), NUM_JOBS);
+        WaitForCounter(&counter);
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Overhead of the serial mode compared to a plain loop and to a single worker thread running the fiber machinery.
+    /// </summary>
+    void RunSerialBenchmark()
+    {
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < NUM_JOBS; ++i)
+        {
+            TinyJob((uintptr_t)i);
+        }
+
+        unsigned long long checksum = 0;
+        for (const unsigned long long result : s_results)
+        {
+            checksum ^= result;
+        }
+        const double loopMs = ElapsedMs(start);
+        printf("Checksum: %llu\n", checksum);
+
+        const double serialMs = RunJobSystem(0);
+        const double singleWorkerMs = RunJobSystem(1);
+
+        PrintResult("serial (200k tiny jobs)", "plain loop", loopMs);
+        PrintResult("serial (200k tiny jobs)", "serial mode", serialMs);
+        PrintResult("serial (200k tiny jobs)", "1 worker thread + fibers", singleWorkerMs);
+    }
+
+#else
+
+    void RunSerialBenchmark()
+    {
+        printf("The serial benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
@@ -0,0 +1,83 @@
+#include "bench.h"
+
+#include "../../src/job-system.h"
+#include "../../src/sharded-counter.h"
+
+#include <vector>
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_FAN_INS = 8;
+    static constexpr int FAN_IN_WIDTH = 100000;
+
+    JobReturnType EmptyFanInChildJob(uintptr_t) { }
+
+    /// <summary>
+    /// Every fan-out kicks 100k children at once, which all decrement the same plain counter.
+    /// </summary>
+    static double RunPlainCounter()
+    {
+        InitializeJobSystem();
+
+        Counter counter = Counter(0);
+        std::vector<Job> jobs(FAN_IN_WIDTH, Job(&EmptyFanInChildJob, &counter, Priority::NORMAL, "EmptyFanInChildJob"));
+
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < NUM_FAN_INS; ++i)
+        {
+            counter.store(FAN_IN_WIDTH);
+            KickJobs(jobs.data(), FAN_IN_WIDTH);
+            WaitForCounter(&counter);
+        }
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Same as above but the children decrement the per-thread shards of a sharded counter.
+    /// </summary>
+    static double RunShardedCounter()
+    {
+        InitializeJobSystem();
+
+        ShardedCounter counter(0);
+        std::vector<Job> jobs(FAN_IN_WIDTH, Job(&EmptyFanInChildJob, counter, Priority::NORMAL, "EmptyFanInChildJob"));
+
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < NUM_FAN_INS; ++i)
+        {
+            counter.Reset(FAN_IN_WIDTH);
+            KickJobs(jobs.data(), FAN_IN_WIDTH);
+            WaitForCounter(counter);
+        }
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Fan-in cost of very wide fan-outs on a single plain counter compared to a sharded counter.
+    /// </summary>
+    void RunShardedCounterBenchmark()
+    {
+        const double plainMs = RunPlainCounter();
+        const double shardedMs = RunShardedCounter();
+
+        PrintResult("fan-in (8 x 100k children)", "plain Counter", plainMs);
+        PrintResult("fan-in (8 x 100k children)", "ShardedCounter", shardedMs);
+    }
+
+#else
+
+    void RunShardedCounterBenchmark()
+    {
+        printf("The sharded counter benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
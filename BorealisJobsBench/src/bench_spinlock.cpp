@@ -0,0 +1,124 @@
+#include "bench.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cmath>
+
+#include "../../src/spinlock.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int RUN_DURATION_MS = 200;
+
+    struct alignas(64) ThreadResult
+    {
+        unsigned long long m_Acquisitions = 0;
+    };
+
+    /// <summary>
+    /// Lets the given amount of threads hammer the lock for a fixed duration and reports the throughput
+    /// and the coefficient of variation of the per-thread acquisitions (0 = perfectly fair).
+    /// </summary>
+    template<typename LockType>
+    static void RunVariant(const char* name, const int threadCount)
+    {
+        LockType lock{};
+        unsigned long long sharedValue = 0;
+
+        std::atomic<bool> start = false;
+        std::atomic<bool> stop = false;
+        std::vector<ThreadResult> results(threadCount);
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                while (!start.load(std::memory_order_acquire)) { }
+
+                unsigned long long acquisitions = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    lock.lock();
+                    ++sharedValue;
+                    lock.unlock();
+                    ++acquisitions;
+                }
+
+                results[t].m_Acquisitions = acquisitions;
+            });
+        }
+
+        start.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(std::chrono::milliseconds(RUN_DURATION_MS));
+        stop.store(true, std::memory_order_relaxed);
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        double total = 0.0;
+        for (const ThreadResult& result : results)
+        {
+            total += (double)result.m_Acquisitions;
+        }
+
+        const double mean = total / threadCount;
+        double variance = 0.0;
+        for (const ThreadResult& result : results)
+        {
+            variance += ((double)result.m_Acquisitions - mean) * ((double)result.m_Acquisitions - mean);
+        }
+        variance /= threadCount;
+
+        const double throughput = total / (RUN_DURATION_MS * 1000.0);
+        const double fairness = mean > 0.0 ? std::sqrt(variance) / mean : 0.0;
+
+        printf("spinlock (%2d threads)        %-16s %10.2f Mops/s   CV %6.3f\n", threadCount, name, throughput, fairness);
+    }
+
+    // Adapters providing the lock / unlock interface of the standard library
+    struct SpinLockAdapter
+    {
+        SpinLock m_Lock{};
+        void lock() { m_Lock.Acquire(); }
+        void unlock() { m_Lock.Release(); }
+    };
+
+    struct TicketSpinLockAdapter
+    {
+        TicketSpinLock m_Lock{};
+        void lock() { m_Lock.Acquire(); }
+        void unlock() { m_Lock.Release(); }
+    };
+
+    /// <summary>
+    /// Acquire / release throughput and fairness of the spinlocks compared to std::mutex across thread counts.
+    /// </summary>
+    void RunSpinLockBenchmark()
+    {
+        const int maxThreads = (int)std::thread::hardware_concurrency();
+
+        for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+        {
+            RunVariant<std::mutex>("std::mutex", threadCount);
+            RunVariant<SpinLockAdapter>("SpinLock", threadCount);
+            RunVariant<TicketSpinLockAdapter>("TicketSpinLock", threadCount);
+        }
+    }
+
+#else
+
+    void RunSpinLockBenchmark()
+    {
+        printf("The spinlock benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
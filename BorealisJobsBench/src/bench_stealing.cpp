@@ -0,0 +1,67 @@
+#include "bench.h"
+
+#include <vector>
+
+#include "../../src/job-system.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_JOBS = 20000;
+    static constexpr int NUM_ROUNDS = 10;
+
+    JobReturnType FanInJob(uintptr_t)
+    {
+        const Clock::time_point start = Clock::now();
+        while (Clock::now() - start < std::chrono::microseconds(20)) { }
+    }
+
+    static double RunFanIn(const std::chrono::microseconds stealBudget)
+    {
+        InitializeJobSystem();
+        SetMainThreadStealBudget(stealBudget);
+
+        std::vector<Job> jobs(NUM_JOBS, Job(&FanInJob, nullptr, Priority::NORMAL, "FanInJob"));
+
+        const Clock::time_point start = Clock::now();
+
+        for (int round = 0; round < NUM_ROUNDS; ++round)
+        {
+            Counter counter = Counter(NUM_JOBS);
+            for (Job& job : jobs)
+            {
+                job.m_pCounter = &counter;
+            }
+
+            KickJobs(jobs.data(), NUM_JOBS);
+            WaitForCounter(&counter);
+        }
+
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Fan-in throughput with the main thread idling in WaitForCounter compared to it helping the workers.
+    /// </summary>
+    void RunStealingBenchmark()
+    {
+        const double idleMs = RunFanIn(std::chrono::microseconds(0));
+        const double stealingMs = RunFanIn(std::chrono::microseconds(MAIN_THREAD_STEAL_BUDGET_US()));
+
+        PrintResult("fan-in (10x 20k 20us jobs)", "main thread waits", idleMs);
+        PrintResult("fan-in (10x 20k 20us jobs)", "main thread steals", stealingMs);
+    }
+
+#else
+
+    void RunStealingBenchmark()
+    {
+        printf("The stealing benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
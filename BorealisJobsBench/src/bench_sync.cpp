@@ -0,0 +1,107 @@
+#include "bench.h"
+
+#include <vector>
+
+#include "../../src/job-system.h"
+#include "../../src/job-sync.h"
+#include "../../src/scoped-spinlock.h"
+
+namespace Borealis::Jobs::Bench
+{
+#ifdef BOREALIS_WIN
+
+    static constexpr int NUM_JOBS = 64;
+    static constexpr int ITERATIONS = 20000;
+    static constexpr int NUM_BUCKETS = 64;
+
+    /// <summary>
+    /// A small amount of private work done outside of the critical section.
+    /// </summary>
+    static unsigned int LocalWork(unsigned int state)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+        }
+
+        return state;
+    }
+
+    template<typename LockFunc>
+    static double RunVariant(LockFunc&& criticalSection)
+    {
+        InitializeJobSystem();
+
+        Counter counter = Counter(NUM_JOBS);
+
+        auto lockJob = [&](uintptr_t seed)
+        {
+            unsigned int state = (unsigned int)seed;
+
+            for (int i = 0; i < ITERATIONS; ++i)
+            {
+                state = LocalWork(state);
+                criticalSection(state);
+            }
+        };
+
+        std::vector<Job> jobs;
+        jobs.reserve(NUM_JOBS);
+        for (int i = 0; i < NUM_JOBS; ++i)
+        {
+            jobs.push_back(Job(lockJob, &counter, Priority::NORMAL, "LockJob", (uintptr_t)i + 1));
+        }
+
+        const Clock::time_point start = Clock::now();
+        KickJobs(jobs.data(), NUM_JOBS);
+        WaitForCounter(&counter);
+        const double elapsed = ElapsedMs(start);
+
+        DeinitializeJobSystem();
+        return elapsed;
+    }
+
+    /// <summary>
+    /// Lock-heavy job workload: Many jobs updating a shared histogram, once guarded by the SpinLock
+    /// and once by the fiber-aware JobMutex.
+    /// </summary>
+    void RunSyncBenchmark()
+    {
+        std::vector<unsigned long long> histogram(NUM_BUCKETS, 0);
+
+        SpinLock spinLock{};
+        const double spinLockMs = RunVariant([&](const unsigned int value)
+        {
+            ScopedSpinLock lock(spinLock);
+            ++histogram[value % NUM_BUCKETS];
+        });
+
+        JobMutex jobMutex{};
+        const double jobMutexMs = RunVariant([&](const unsigned int value)
+        {
+            ScopedJobLock lock(jobMutex);
+            ++histogram[value % NUM_BUCKETS];
+        });
+
+        PrintResult("sync (64 jobs x 20000 locks)", "SpinLock", spinLockMs);
+        PrintResult("sync (64 jobs x 20000 locks)", "JobMutex", jobMutexMs);
+
+        unsigned long long total = 0;
+        for (const unsigned long long bucket : histogram)
+        {
+            total += bucket;
+        }
+
+        if (total != 2ull * NUM_JOBS * ITERATIONS)
+            printf("WARNING: Lost updates in the histogram!\n");
+    }
+
+#else
+
+    void RunSyncBenchmark()
+    {
+        printf("The sync benchmark is currently only available for Windows.\n");
+    }
+
+#endif
+}
@@ -0,0 +1,51 @@
+#include "bench.h"
+
+#include <cstring>
+
+using namespace Borealis::Jobs::Bench;
+
+struct BenchmarkEntry
+{
+    const char* m_Name;
+    void (*m_Run)();
+};
+
+static const BenchmarkEntry s_benchmarks[] =
+{
+    { "io", &RunIoBenchmark },
+    { "sync", &RunSyncBenchmark },
+    { "spinlock", &RunSpinLockBenchmark },
+    { "serial", &RunSerialBenchmark },
+    { "batching", &RunBatchingBenchmark },
+    { "counters", &RunCounterBenchmark },
+    { "algorithms", &RunAlgorithmBenchmark },
+    { "stealing", &RunStealingBenchmark },
+    { "layout", &RunLayoutBenchmark },
+    { "costmodel", &RunCostModelBenchmark },
+    { "fanin", &RunShardedCounterBenchmark },
+    { "priority", &RunPriorityBenchmark },
+};
+
+/// <summary>
+/// Runs all benchmarks or only the ones given by name on the command line, e.g. "BorealisJobsBench io".
+/// </summary>
+int main(int argc, char** argv)
+{
+    for (const BenchmarkEntry& entry : s_benchmarks)
+    {
+        bool selected = argc < 2;
+
+        for (int i = 1; i < argc && !selected; ++i)
+        {
+            selected = strcmp(argv[i], entry.m_Name) == 0;
+        }
+
+        if (selected)
+        {
+            printf("---------- %s ----------\n", entry.m_Name);
+            entry.m_Run();
+        }
+    }
+
+    return 0;
+}
@@ -1,3 +1,6 @@
+#pragma once
+#include <cstddef>
+
 #ifdef BOREALIS_BUILD_DLL
 #define BOREALIS_API __declspec(dllexport)
 #else
@@ -10,4 +13,139 @@ static constexpr int NUM_FIBERS()
 }
 
 static_assert(NUM_FIBERS() < 2028,
-	"There can only be a maximum of 2028 fibers present at the same time!");
\ No newline at end of file
+	"There can only be a maximum of 2028 fibers present at the same time!");
+
+// Size of a cache line on the supported x64 and ARM64 targets. Data written by different threads is aligned to it
+// to avoid false sharing. Not derived from std::hardware_destructive_interference_size, since that may change between compilers.
+static constexpr size_t CACHE_LINE_SIZE()
+{
+	return 64;
+}
+
+static constexpr int MAX_IO_COMPLETIONS_PER_POLL()
+{
+	return 16;
+}
+
+static constexpr int SYNC_SPIN_COUNT()
+{
+	return 64;
+}
+
+static constexpr int READY_FIBER_STEAL_THRESHOLD_US()
+{
+	return 50;
+}
+
+static constexpr int MAX_JOB_BATCH_SIZE()
+{
+	return 16;
+}
+
+static constexpr double JOB_BATCH_TARGET_NS()
+{
+	return 20000.0;
+}
+
+// Time the main thread may spend on jobs stolen from the worker queues while its own fiber waits. Stolen batches are sized
+// by the learned job costs to fit into it and job types exceeding it are not stolen, so resuming the main thread is
+// delayed by about this much.
+static constexpr int MAIN_THREAD_STEAL_BUDGET_US()
+{
+	return 1000;
+}
+
+// Capacity of the learned job cost table. Must be a power of two.
+static constexpr size_t JOB_COST_TABLE_SIZE()
+{
+	return 1024;
+}
+
+// How many jobs at the back of each lower priority queue a waiting job searches for jobs signalling its counter. Children
+// are usually kicked right before their parent waits, so they are found near the back without scanning whole backlogs.
+static constexpr int PRIORITY_INHERITANCE_SCAN_DEPTH()
+{
+	return 64;
+}
+
+// Every n-th job executed by a worker is timed and recorded in the job cost table
+static constexpr int JOB_COST_SAMPLE_INTERVAL()
+{
+	return 4;
+}
+
+// Jobs learned to run shorter than this are executed inline by KickOrInline, since queueing them would cost more
+static constexpr double JOB_INLINE_THRESHOLD_NS()
+{
+	return 1000.0;
+}
+
+static constexpr int WORKER_SCALING_INTERVAL_MS()
+{
+	return 5;
+}
+
+// Estimated time a freshly kicked job has to wait for a worker, above which the pool is considered under pressure
+static constexpr double WORKER_GROW_WAIT_US()
+{
+	return 500.0;
+}
+
+// Consecutive samples of pressure / idleness before a worker is added / retired. Retiring is deliberately
+// much slower than growing, so bursty loads don't make the pool flap.
+static constexpr int WORKER_GROW_SAMPLES()
+{
+	return 4;
+}
+
+static constexpr int WORKER_RETIRE_SAMPLES()
+{
+	return 100;
+}
+
+// Share of the sampling interval the workers spent executing jobs, below which a sample counts as idle
+static constexpr double WORKER_RETIRE_UTILIZATION()
+{
+	return 0.5;
+}
+
+// Pooled counters are allocated in chunks which are never moved, so handles can be resolved without locking
+static constexpr int COUNTER_POOL_CHUNK_SIZE()
+{
+	return 256;
+}
+
+static constexpr int MAX_COUNTER_POOL_CHUNKS()
+{
+	return 256;
+}
+
+// The maximum amount of shards of a sharded counter, which gets one shard per logical core below that
+static constexpr int MAX_COUNTER_SHARDS()
+{
+	return 64;
+}
+
+// Ranges below this amount of elements are processed serially by the parallel algorithms
+static constexpr size_t PARALLEL_SERIAL_THRESHOLD()
+{
+	return 32768;
+}
+
+// The parallel algorithms split ranges into blocks of at least this amount of elements...
+static constexpr size_t PARALLEL_MIN_BLOCK_SIZE()
+{
+	return 4096;
+}
+
+// ...and at most this amount of bytes, so a block stays within the per-core L2 cache...
+static constexpr size_t PARALLEL_MAX_BLOCK_BYTES()
+{
+	return 256 * 1024;
+}
+
+// ...and otherwise aim for this amount of blocks per worker to balance the load.
+static constexpr size_t PARALLEL_BLOCKS_PER_WORKER()
+{
+	return 4;
+}
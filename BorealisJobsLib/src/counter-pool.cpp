@@ -0,0 +1,132 @@
+#include "counter-pool.h"
+#include "scoped-spinlock.h"
+#include "spinlock.h"
+
+#include <assert.h>
+#include <atomic>
+#include <vector>
+
+namespace Borealis::Jobs
+{
+	/// <summary>
+	/// A counter slot of the pool.
+	/// </summary>
+	struct PooledCounter
+	{
+		Counter m_Value = Counter(0);
+		std::atomic<unsigned int> m_Generation = 0;
+		std::atomic<int> m_References = 0;
+	};
+
+	/// <summary>
+	/// Owns the counter chunks. Chunks are only ever appended, so resolving a handle only needs an acquire load.
+	/// </summary>
+	struct CounterChunks
+	{
+		std::atomic<PooledCounter*> m_Chunks[MAX_COUNTER_POOL_CHUNKS()] = {};
+		int m_NumChunks = 0;
+
+		~CounterChunks()
+		{
+			for (int i = 0; i < m_NumChunks; ++i)
+			{
+				delete[] m_Chunks[i].load(std::memory_order_relaxed);
+			}
+		}
+	};
+
+	// ------------------ Counter pool data ------------------
+	CounterChunks g_counterChunks{};
+	std::vector<unsigned int> g_freeCounters{};
+	std::atomic<int> g_numAllocatedCounters(0);
+	SpinLock counter_pool_sl{};
+
+	/// <summary>
+	/// Returns the slot of the given index. The chunk has to exist already.
+	/// </summary>
+	static PooledCounter& GetPooledCounter(const unsigned int index)
+	{
+		PooledCounter* chunk = g_counterChunks.m_Chunks[index / COUNTER_POOL_CHUNK_SIZE()].load(std::memory_order_acquire);
+		assert(chunk != nullptr);
+
+		return chunk[index % COUNTER_POOL_CHUNK_SIZE()];
+	}
+
+	/// <summary>
+	/// Adds a new chunk of counters to the free list. Has to be called while holding the pool lock.
+	/// </summary>
+	static void GrowCounterPool()
+	{
+		assert(g_counterChunks.m_NumChunks < MAX_COUNTER_POOL_CHUNKS() && "The counter pool is exhausted!");
+
+		const unsigned int chunkIndex = (unsigned int)g_counterChunks.m_NumChunks++;
+		g_counterChunks.m_Chunks[chunkIndex].store(new PooledCounter[COUNTER_POOL_CHUNK_SIZE()], std::memory_order_release);
+
+		// Reversed, so the lowest indices are handed out first
+		for (int i = COUNTER_POOL_CHUNK_SIZE() - 1; i >= 0; --i)
+		{
+			g_freeCounters.push_back(chunkIndex * COUNTER_POOL_CHUNK_SIZE() + i);
+		}
+	}
+
+	CounterHandle AllocateCounter(const int initialCount, const int numWaiters)
+	{
+		assert(numWaiters > 0);
+
+		unsigned int index = INVALID_COUNTER_INDEX;
+
+		{
+			ScopedSpinLock lock(counter_pool_sl);
+
+			if (g_freeCounters.empty())
+				GrowCounterPool();
+
+			index = g_freeCounters.back();
+			g_freeCounters.pop_back();
+		}
+
+		PooledCounter& counter = GetPooledCounter(index);
+		counter.m_Value.store(initialCount, std::memory_order_relaxed);
+		counter.m_References.store(numWaiters, std::memory_order_release);
+
+		g_numAllocatedCounters.fetch_add(1, std::memory_order_relaxed);
+
+		return CounterHandle{ index, counter.m_Generation.load(std::memory_order_relaxed) };
+	}
+
+	Counter* GetCounter(const CounterHandle handle)
+	{
+		if (!handle.IsValid())
+			return nullptr;
+
+		PooledCounter& counter = GetPooledCounter(handle.m_Index);
+
+		if (counter.m_Generation.load(std::memory_order_acquire) != handle.m_Generation)
+			return nullptr;
+
+		return &counter.m_Value;
+	}
+
+	void ReleaseCounter(const CounterHandle handle)
+	{
+		assert(handle.IsValid());
+
+		PooledCounter& counter = GetPooledCounter(handle.m_Index);
+		assert(counter.m_Generation.load(std::memory_order_relaxed) == handle.m_Generation && "Releasing a stale counter handle!");
+
+		if (counter.m_References.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		// Last waiter -> Invalidate all outstanding handles before the slot can be handed out again
+		counter.m_Generation.fetch_add(1, std::memory_order_release);
+		g_numAllocatedCounters.fetch_sub(1, std::memory_order_relaxed);
+
+		ScopedSpinLock lock(counter_pool_sl);
+		g_freeCounters.push_back(handle.m_Index);
+	}
+
+	int GetNumAllocatedCounters()
+	{
+		return g_numAllocatedCounters.load(std::memory_order_relaxed);
+	}
+}
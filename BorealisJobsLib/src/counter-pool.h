@@ -0,0 +1,55 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+
+namespace Borealis::Jobs
+{
+	static constexpr unsigned int INVALID_COUNTER_INDEX = 0xFFFFFFFF;
+
+	/// <summary>
+	/// A handle to a pooled counter. The generation is bumped whenever the counter is recycled,
+	/// so stale handles are detected instead of silently aliasing a new fan-out.
+	/// </summary>
+	struct CounterHandle
+	{
+		unsigned int m_Index = INVALID_COUNTER_INDEX;
+		unsigned int m_Generation = 0;
+
+		bool IsValid() const
+		{
+			return m_Index != INVALID_COUNTER_INDEX;
+		}
+
+		bool operator ==(const CounterHandle& other) const
+		{
+			return m_Index == other.m_Index && m_Generation == other.m_Generation;
+		}
+	};
+
+	/// <summary>
+	/// Takes a counter from the pool. The counter is recycled automatically once the given amount of waiters
+	/// resumed from WaitForCounterAndFree (or dropped their reference through ReleaseCounter).
+	/// </summary>
+	/// <param name="initialCount">The initial value of the counter, usually the amount of jobs to wait for.</param>
+	/// <param name="numWaiters">The amount of waiters that will free the counter.</param>
+	/// <returns>The handle of the counter.</returns>
+	BOREALIS_API CounterHandle AllocateCounter(const int initialCount, const int numWaiters = 1);
+
+	/// <summary>
+	/// Resolves the handle to the underlying counter, which can be handed to jobs.
+	/// </summary>
+	/// <param name="handle">The counter handle.</param>
+	/// <returns>The counter or nullptr if the handle is invalid or stale.</returns>
+	BOREALIS_API Counter* GetCounter(const CounterHandle handle);
+
+	/// <summary>
+	/// Drops a waiter reference without waiting. The last reference recycles the counter.
+	/// </summary>
+	/// <param name="handle">The counter handle. Must not be stale.</param>
+	BOREALIS_API void ReleaseCounter(const CounterHandle handle);
+
+	/// <summary>
+	/// Returns the amount of counters currently handed out by the pool.
+	/// </summary>
+	BOREALIS_API int GetNumAllocatedCounters();
+}
@@ -0,0 +1,366 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+#include "job-system.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace Borealis::Jobs
+{
+	// Data-parallel building blocks running on the workers of the current scheduler. All of them fan out into jobs
+	// and wait for them through a counter, so they have to be called from within a job or the main fiber.
+
+	namespace Detail
+	{
+		/// <summary>
+		/// Returns the amount of elements per block for the given range. Blocks stay within the L2 cache
+		/// but are small enough to give every worker a few of them.
+		/// </summary>
+		template<typename T>
+		size_t GetBlockSize(const size_t count)
+		{
+			const size_t numWorkers = (size_t)std::max(JobScheduler::Current().GetNumWorkers(), 1);
+			const size_t maxBlockSize = std::max(PARALLEL_MAX_BLOCK_BYTES() / sizeof(T), PARALLEL_MIN_BLOCK_SIZE());
+			const size_t balancedBlockSize = (count + numWorkers * PARALLEL_BLOCKS_PER_WORKER() - 1) / (numWorkers * PARALLEL_BLOCKS_PER_WORKER());
+
+			return std::clamp(balancedBlockSize, PARALLEL_MIN_BLOCK_SIZE(), maxBlockSize);
+		}
+
+		/// <summary>
+		/// Whether the range is too small or the scheduler has no workers, so the serial algorithm is faster.
+		/// </summary>
+		inline bool RunSerially(const size_t count)
+		{
+			return count < PARALLEL_SERIAL_THRESHOLD() || JobScheduler::Current().GetNumWorkers() == 0;
+		}
+
+		/// <summary>
+		/// Runs func(index) for every index in [0, count) as a job and waits for all of them.
+		/// The jobs are kicked with high priority, so an algorithm in flight finishes before new work is started.
+		/// </summary>
+		template<typename Func>
+		void ParallelFor(const size_t count, const Func& func)
+		{
+			if (count == 0)
+				return;
+
+			Counter counter = Counter((int)count);
+
+			std::vector<Job> jobs;
+			jobs.reserve(count);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				jobs.emplace_back([&func](uintptr_t index) { func((size_t)index); }, &counter, Priority::HIGH, "ParallelFor", (uintptr_t)i);
+			}
+
+			KickJobs(jobs.data(), (int)count);
+			WaitForCounter(&counter);
+		}
+
+		/// <summary>
+		/// Returns how many elements of the first run belong to the first outputIndex elements of the stable merge
+		/// of both runs (merge path). Elements of the first run precede equal elements of the second one.
+		/// </summary>
+		template<typename ItA, typename ItB, typename Compare>
+		size_t CoRank(const size_t outputIndex, ItA a, const size_t sizeA, ItB b, const size_t sizeB, Compare& comp)
+		{
+			size_t low = outputIndex > sizeB ? outputIndex - sizeB : 0;
+			size_t high = std::min(outputIndex, sizeA);
+
+			while (low < high)
+			{
+				const size_t i = low + (high - low) / 2;
+				const size_t j = outputIndex - i;
+
+				// a[i] has to be emitted before b[j - 1] -> more elements of the first run are needed
+				if (j > 0 && !comp(b[j - 1], a[i]))
+					low = i + 1;
+				else
+					high = i;
+			}
+
+			return low;
+		}
+
+		/// <summary>
+		/// Merges neighbouring sorted runs of the given width from src into dst. Each merge is split along
+		/// the merge path into chunks of blockSize output elements, which are merged in parallel.
+		/// </summary>
+		template<typename SrcIt, typename DstIt, typename Compare>
+		void MergePass(SrcIt src, DstIt dst, const size_t count, const size_t width, const size_t blockSize, Compare& comp)
+		{
+			struct MergeChunk
+			{
+				size_t m_BeginA, m_EndA;
+				size_t m_BeginB, m_EndB;
+				size_t m_Output;
+			};
+
+			std::vector<MergeChunk> chunks;
+
+			for (size_t low = 0; low < count; low += 2 * width)
+			{
+				const size_t mid = std::min(low + width, count);
+				const size_t high = std::min(low + 2 * width, count);
+				const size_t sizeA = mid - low;
+				const size_t sizeB = high - mid;
+
+				size_t previousA = 0;
+
+				for (size_t begin = 0; begin < sizeA + sizeB; begin += blockSize)
+				{
+					const size_t end = std::min(begin + blockSize, sizeA + sizeB);
+					const size_t endA = CoRank(end, src + low, sizeA, src + mid, sizeB, comp);
+
+					chunks.push_back(MergeChunk{ low + previousA, low + endA, mid + (begin - previousA), mid + (end - endA), low + begin });
+					previousA = endA;
+				}
+			}
+
+			ParallelFor(chunks.size(), [&](const size_t index)
+			{
+				const MergeChunk& chunk = chunks[index];
+
+				std::merge(std::make_move_iterator(src + chunk.m_BeginA), std::make_move_iterator(src + chunk.m_EndA),
+					std::make_move_iterator(src + chunk.m_BeginB), std::make_move_iterator(src + chunk.m_EndB),
+					dst + chunk.m_Output, comp);
+			});
+		}
+	}
+
+	/// <summary>
+	/// Sorts the range with a parallel merge sort: Cache sized blocks are sorted concurrently and then merged
+	/// pairwise, where every merge is split into equally sized chunks along the merge path.
+	/// Needs a temporary buffer of the size of the range, hence the value type has to be default constructible.
+	/// </summary>
+	/// <param name="first">The beginning of the range.</param>
+	/// <param name="last">The end of the range.</param>
+	/// <param name="comp">The strict weak ordering to sort by.</param>
+	template<typename RandomIt, typename Compare = std::less<>>
+	void ParallelSort(RandomIt first, RandomIt last, Compare comp = Compare())
+	{
+		typedef typename std::iterator_traits<RandomIt>::value_type ValueType;
+		static_assert(std::is_default_constructible_v<ValueType>, "ParallelSort needs a default constructible value type for its merge buffer!");
+
+		const size_t count = (size_t)std::distance(first, last);
+
+		if (Detail::RunSerially(count))
+		{
+			std::sort(first, last, comp);
+			return;
+		}
+
+		const size_t blockSize = Detail::GetBlockSize<ValueType>(count);
+		const size_t numBlocks = (count + blockSize - 1) / blockSize;
+
+		Detail::ParallelFor(numBlocks, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			std::sort(first + begin, first + std::min(begin + blockSize, count), comp);
+		});
+
+		if (numBlocks == 1)
+			return;
+
+		std::vector<ValueType> buffer(count);
+		bool inBuffer = false;
+
+		for (size_t width = blockSize; width < count; width *= 2)
+		{
+			if (inBuffer)
+				Detail::MergePass(buffer.begin(), first, count, width, blockSize, comp);
+			else
+				Detail::MergePass(first, buffer.begin(), count, width, blockSize, comp);
+
+			inBuffer = !inBuffer;
+		}
+
+		if (!inBuffer)
+			return;
+
+		Detail::ParallelFor(numBlocks, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			const size_t end = std::min(begin + blockSize, count);
+			std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+		});
+	}
+
+	/// <summary>
+	/// Computes the inclusive prefix scan of the range in three passes: per block reductions, a serial scan
+	/// of the block results and a per block scan seeded with the preceding blocks. The output may alias the input.
+	/// The block results are kept in a buffer, hence the value type has to be default constructible.
+	/// </summary>
+	/// <param name="first">The beginning of the input range.</param>
+	/// <param name="last">The end of the input range.</param>
+	/// <param name="output">The beginning of the output range.</param>
+	/// <param name="op">An associative binary operation.</param>
+	/// <returns>The end of the output range.</returns>
+	template<typename InputIt, typename OutputIt, typename BinaryOp = std::plus<>>
+	OutputIt ParallelInclusiveScan(InputIt first, InputIt last, OutputIt output, BinaryOp op = BinaryOp())
+	{
+		typedef typename std::iterator_traits<InputIt>::value_type ValueType;
+		static_assert(std::is_default_constructible_v<ValueType>, "ParallelInclusiveScan needs a default constructible value type for its block results!");
+
+		const size_t count = (size_t)std::distance(first, last);
+
+		if (Detail::RunSerially(count))
+			return std::inclusive_scan(first, last, output, op);
+
+		const size_t blockSize = Detail::GetBlockSize<ValueType>(count);
+		const size_t numBlocks = (count + blockSize - 1) / blockSize;
+
+		// The last block's total is never needed
+		std::vector<ValueType> blockTotals(numBlocks - 1);
+
+		Detail::ParallelFor(numBlocks - 1, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			blockTotals[block] = std::accumulate(first + begin + 1, first + begin + blockSize, ValueType(first[begin]), op);
+		});
+
+		// blockTotals[b] becomes the total of all blocks up to and including b
+		std::inclusive_scan(blockTotals.begin(), blockTotals.end(), blockTotals.begin(), op);
+
+		Detail::ParallelFor(numBlocks, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			const size_t end = std::min(begin + blockSize, count);
+
+			if (block == 0)
+				std::inclusive_scan(first + begin, first + end, output + begin, op);
+			else
+				std::inclusive_scan(first + begin, first + end, output + begin, op, blockTotals[block - 1]);
+		});
+
+		return output + count;
+	}
+
+	/// <summary>
+	/// Computes the exclusive prefix scan of the range like ParallelInclusiveScan. The output may alias the input.
+	/// The block offsets are kept in a buffer, hence the type of the initial value has to be default constructible.
+	/// </summary>
+	/// <param name="first">The beginning of the input range.</param>
+	/// <param name="last">The end of the input range.</param>
+	/// <param name="output">The beginning of the output range.</param>
+	/// <param name="init">The initial value, which is the first output element.</param>
+	/// <param name="op">An associative binary operation.</param>
+	/// <returns>The end of the output range.</returns>
+	template<typename InputIt, typename OutputIt, typename T, typename BinaryOp = std::plus<>>
+	OutputIt ParallelExclusiveScan(InputIt first, InputIt last, OutputIt output, T init, BinaryOp op = BinaryOp())
+	{
+		static_assert(std::is_default_constructible_v<T>, "ParallelExclusiveScan needs a default constructible initial value type for its block offsets!");
+
+		const size_t count = (size_t)std::distance(first, last);
+
+		if (Detail::RunSerially(count))
+			return std::exclusive_scan(first, last, output, init, op);
+
+		// The blocks are sized by the elements they read, not by the accumulator
+		const size_t blockSize = Detail::GetBlockSize<std::iter_value_t<InputIt>>(count);
+		const size_t numBlocks = (count + blockSize - 1) / blockSize;
+
+		std::vector<T> blockOffsets(numBlocks);
+
+		Detail::ParallelFor(numBlocks - 1, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			blockOffsets[block + 1] = std::accumulate(first + begin + 1, first + begin + blockSize, T(first[begin]), op);
+		});
+
+		// blockOffsets[b] becomes init combined with the totals of all blocks before b
+		blockOffsets[0] = init;
+		std::inclusive_scan(blockOffsets.begin(), blockOffsets.end(), blockOffsets.begin(), op);
+
+		Detail::ParallelFor(numBlocks, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			const size_t end = std::min(begin + blockSize, count);
+
+			std::exclusive_scan(first + begin, first + end, output + begin, blockOffsets[block], op);
+		});
+
+		return output + count;
+	}
+
+	/// <summary>
+	/// Reorders the range so all elements satisfying the predicate precede the others while keeping the relative
+	/// order within both groups. The predicate is evaluated once per element in parallel, the block offsets of both
+	/// groups are scanned and every block scatters its elements into a buffer, which is moved back afterwards.
+	/// The value type therefore has to be default constructible.
+	/// </summary>
+	/// <param name="first">The beginning of the range.</param>
+	/// <param name="last">The end of the range.</param>
+	/// <param name="pred">The predicate selecting the elements of the first group.</param>
+	/// <returns>The beginning of the second group.</returns>
+	template<typename RandomIt, typename UnaryPredicate>
+	RandomIt ParallelStablePartition(RandomIt first, RandomIt last, UnaryPredicate pred)
+	{
+		typedef typename std::iterator_traits<RandomIt>::value_type ValueType;
+		static_assert(std::is_default_constructible_v<ValueType>, "ParallelStablePartition needs a default constructible value type for its scatter buffer!");
+
+		const size_t count = (size_t)std::distance(first, last);
+
+		if (Detail::RunSerially(count))
+			return std::stable_partition(first, last, pred);
+
+		const size_t blockSize = Detail::GetBlockSize<ValueType>(count);
+		const size_t numBlocks = (count + blockSize - 1) / blockSize;
+
+		std::vector<unsigned char> selected(count);
+		std::vector<size_t> blockSelected(numBlocks + 1, 0);
+
+		Detail::ParallelFor(numBlocks, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			const size_t end = std::min(begin + blockSize, count);
+
+			size_t numSelected = 0;
+			for (size_t i = begin; i < end; ++i)
+			{
+				selected[i] = pred(first[i]) ? 1 : 0;
+				numSelected += selected[i];
+			}
+
+			blockSelected[block + 1] = numSelected;
+		});
+
+		// blockSelected[b] becomes the amount of selected elements in front of block b
+		std::inclusive_scan(blockSelected.begin(), blockSelected.end(), blockSelected.begin());
+		const size_t totalSelected = blockSelected[numBlocks];
+
+		std::vector<ValueType> buffer(count);
+
+		Detail::ParallelFor(numBlocks, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			const size_t end = std::min(begin + blockSize, count);
+
+			size_t selectedOutput = blockSelected[block];
+			size_t rejectedOutput = totalSelected + (begin - blockSelected[block]);
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				if (selected[i])
+					buffer[selectedOutput++] = std::move(first[i]);
+				else
+					buffer[rejectedOutput++] = std::move(first[i]);
+			}
+		});
+
+		Detail::ParallelFor(numBlocks, [&](const size_t block)
+		{
+			const size_t begin = block * blockSize;
+			const size_t end = std::min(begin + blockSize, count);
+			std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+		});
+
+		return first + totalSelected;
+	}
+}
@@ -0,0 +1,227 @@
+#include "job-cost-model.h"
+#include "scoped-spinlock.h"
+#include "spinlock.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+
+namespace Borealis::Jobs
+{
+	static_assert((JOB_COST_TABLE_SIZE() & (JOB_COST_TABLE_SIZE() - 1)) == 0, "The job cost table size must be a power of two!");
+
+	static constexpr double JOB_COST_SMOOTHING = 0.125;
+	static constexpr size_t EMPTY_HASH = 0;
+
+	/// <summary>
+	/// A slot of the open addressing table. Recording only touches the atomics, so each job type gets its own
+	/// cache line and workers recording different types don't invalidate each other.
+	/// </summary>
+	struct alignas(CACHE_LINE_SIZE()) JobCostSlot
+	{
+		std::atomic<size_t> m_Hash = EMPTY_HASH;	// Published last, once the slot is complete
+		std::atomic<double> m_AverageNs = 0.0;
+		std::atomic<unsigned int> m_NumSamples = 0;
+		std::string m_FunctionName{};				// Written before the hash is published, immutable afterwards
+	};
+
+	// ------------------ Job cost data ------------------
+	JobCostSlot g_jobCostSlots[JOB_COST_TABLE_SIZE()] = {};
+	int g_numJobCostSlots = 0;
+	SpinLock job_cost_sl{};
+
+	/// <summary>
+	/// Hashes the function name. 0 marks empty slots and is therefore never returned.
+	/// </summary>
+	static size_t HashFunctionName(const std::string& functionName)
+	{
+		const size_t hash = std::hash<std::string>{}(functionName);
+		return hash != EMPTY_HASH ? hash : 1;
+	}
+
+	/// <summary>
+	/// Looks up the slot of the job type without locking. Job types whose hashes collide are told apart by their names.
+	/// </summary>
+	/// <returns>The slot or nullptr if the job type is not in the table.</returns>
+	static JobCostSlot* FindJobCostSlot(const std::string& functionName, const size_t hash)
+	{
+		for (size_t probe = 0; probe < JOB_COST_TABLE_SIZE(); ++probe)
+		{
+			JobCostSlot& slot = g_jobCostSlots[(hash + probe) & (JOB_COST_TABLE_SIZE() - 1)];
+			const size_t slotHash = slot.m_Hash.load(std::memory_order_acquire);
+
+			if (slotHash == hash && slot.m_FunctionName == functionName)
+				return &slot;
+
+			// Slots are only ever freed all at once -> The first empty slot ends the probe sequence
+			if (slotHash == EMPTY_HASH)
+				return nullptr;
+		}
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Returns the slot of the job type and inserts it if it doesn't exist yet.
+	/// </summary>
+	/// <returns>The slot or nullptr if the table is full.</returns>
+	static JobCostSlot* FindOrInsertJobCostSlot(const std::string& functionName, const size_t hash, const double initialNs)
+	{
+		if (JobCostSlot* slot = FindJobCostSlot(functionName, hash))
+			return slot;
+
+		ScopedSpinLock lock(job_cost_sl);
+
+		for (size_t probe = 0; probe < JOB_COST_TABLE_SIZE(); ++probe)
+		{
+			JobCostSlot& slot = g_jobCostSlots[(hash + probe) & (JOB_COST_TABLE_SIZE() - 1)];
+			const size_t slotHash = slot.m_Hash.load(std::memory_order_relaxed);
+
+			// Somebody else inserted it in the meantime
+			if (slotHash == hash && slot.m_FunctionName == functionName)
+				return &slot;
+
+			if (slotHash != EMPTY_HASH)
+				continue;
+
+			slot.m_FunctionName = functionName;
+			slot.m_AverageNs.store(initialNs, std::memory_order_relaxed);
+			slot.m_NumSamples.store(0, std::memory_order_relaxed);
+			slot.m_Hash.store(hash, std::memory_order_release);
+
+			++g_numJobCostSlots;
+			return &slot;
+		}
+
+		return nullptr;
+	}
+
+	void RecordJobCost(const std::string& functionName, const double elapsedNs)
+	{
+		if (functionName.empty())
+			return;
+
+		JobCostSlot* slot = FindOrInsertJobCostSlot(functionName, HashFunctionName(functionName), elapsedNs);
+		if (slot == nullptr)
+			return;	// Table is full -> The job type is simply not learned
+
+		// The first sample replaces the initial value, every further one is smoothed in
+		const bool first = slot->m_NumSamples.fetch_add(1, std::memory_order_relaxed) == 0;
+
+		double average = slot->m_AverageNs.load(std::memory_order_relaxed);
+		double updated = 0.0;
+
+		do
+		{
+			updated = first ? elapsedNs : average + (elapsedNs - average) * JOB_COST_SMOOTHING;
+		} while (!slot->m_AverageNs.compare_exchange_weak(average, updated, std::memory_order_relaxed));
+	}
+
+	bool GetJobCostEstimate(const std::string& functionName, double& estimateNs)
+	{
+		if (functionName.empty())
+			return false;
+
+		const JobCostSlot* slot = FindJobCostSlot(functionName, HashFunctionName(functionName));
+		if (slot == nullptr)
+			return false;
+
+		estimateNs = slot->m_AverageNs.load(std::memory_order_relaxed);
+		return true;
+	}
+
+	std::vector<JobCost> DumpJobCosts()
+	{
+		ScopedSpinLock lock(job_cost_sl);
+
+		std::vector<JobCost> costs;
+		costs.reserve(g_numJobCostSlots);
+
+		for (const JobCostSlot& slot : g_jobCostSlots)
+		{
+			if (slot.m_Hash.load(std::memory_order_relaxed) == EMPTY_HASH)
+				continue;
+
+			costs.push_back(JobCost{ slot.m_FunctionName, slot.m_AverageNs.load(std::memory_order_relaxed), slot.m_NumSamples.load(std::memory_order_relaxed) });
+		}
+
+		return costs;
+	}
+
+	void PreloadJobCosts(const std::vector<JobCost>& costs)
+	{
+		for (const JobCost& cost : costs)
+		{
+			if (cost.m_FunctionName.empty())
+				continue;
+
+			JobCostSlot* slot = FindOrInsertJobCostSlot(cost.m_FunctionName, HashFunctionName(cost.m_FunctionName), cost.m_AverageNs);
+			if (slot == nullptr)
+				return;
+
+			slot->m_AverageNs.store(cost.m_AverageNs, std::memory_order_relaxed);
+			slot->m_NumSamples.store(std::max(cost.m_NumSamples, 1u), std::memory_order_relaxed);
+		}
+	}
+
+	bool SaveJobCosts(const char* path)
+	{
+		std::ofstream file(path);
+		if (!file.is_open())
+		{
+			printf("Failed to open %s for writing the job costs\n", path);
+			return false;
+		}
+
+		file << std::fixed << std::setprecision(1);
+
+		for (const JobCost& cost : DumpJobCosts())
+		{
+			file << cost.m_AverageNs << ' ' << cost.m_NumSamples << ' ' << cost.m_FunctionName << '\n';
+		}
+
+		return true;
+	}
+
+	bool LoadJobCosts(const char* path)
+	{
+		std::ifstream file(path);
+		if (!file.is_open())
+		{
+			printf("Failed to open %s for reading the job costs\n", path);
+			return false;
+		}
+
+		std::vector<JobCost> costs;
+		JobCost cost{};
+
+		// The function name is the rest of the line, since stringified entry points may contain spaces
+		while (file >> cost.m_AverageNs >> cost.m_NumSamples >> std::ws && std::getline(file, cost.m_FunctionName))
+		{
+			if (!cost.m_FunctionName.empty() && cost.m_FunctionName.back() == '\r')
+				cost.m_FunctionName.pop_back();
+
+			costs.push_back(cost);
+		}
+
+		PreloadJobCosts(costs);
+		return true;
+	}
+
+	void ResetJobCosts()
+	{
+		ScopedSpinLock lock(job_cost_sl);
+
+		for (JobCostSlot& slot : g_jobCostSlots)
+		{
+			slot.m_Hash.store(EMPTY_HASH, std::memory_order_relaxed);
+			slot.m_FunctionName.clear();
+		}
+
+		g_numJobCostSlots = 0;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+
+#include <string>
+#include <vector>
+
+namespace Borealis::Jobs
+{
+	/// <summary>
+	/// The learned cost of a job type, identified by the job's function name.
+	/// </summary>
+	struct JobCost
+	{
+		std::string m_FunctionName{};
+		double m_AverageNs = 0.0;			// Exponential moving average of the execution time
+		unsigned int m_NumSamples = 0;
+	};
+
+	/// <summary>
+	/// Feeds an observed execution time into the moving average of the job type. The workers sample every
+	/// JOB_COST_SAMPLE_INTERVAL-th job they execute, unnamed jobs are never recorded.
+	/// </summary>
+	/// <param name="functionName">The function name of the job.</param>
+	/// <param name="elapsedNs">The execution time of the job.</param>
+	BOREALIS_API void RecordJobCost(const std::string& functionName, const double elapsedNs);
+
+	/// <summary>
+	/// Returns the learned execution time of the job type.
+	/// </summary>
+	/// <param name="functionName">The function name of the job.</param>
+	/// <param name="estimateNs">Receives the moving average of the execution time.</param>
+	/// <returns>False if the job type was never recorded.</returns>
+	BOREALIS_API bool GetJobCostEstimate(const std::string& functionName, double& estimateNs);
+
+	/// <summary>
+	/// Returns a snapshot of the learned table.
+	/// </summary>
+	BOREALIS_API std::vector<JobCost> DumpJobCosts();
+
+	/// <summary>
+	/// Seeds the table with costs dumped by a previous run, so warm starts make the right decisions from the first frame on.
+	/// Overwrites the costs of job types already present.
+	/// </summary>
+	BOREALIS_API void PreloadJobCosts(const std::vector<JobCost>& costs);
+
+	/// <summary>
+	/// Writes the learned table to a text file with one "averageNs samples functionName" line per job type.
+	/// </summary>
+	/// <returns>True if the file was written.</returns>
+	BOREALIS_API bool SaveJobCosts(const char* path);
+
+	/// <summary>
+	/// Preloads the table from a file written by SaveJobCosts.
+	/// </summary>
+	/// <returns>True if the file was read.</returns>
+	BOREALIS_API bool LoadJobCosts(const char* path);
+
+	/// <summary>
+	/// Forgets every learned cost. Must not be called while jobs are being executed.
+	/// </summary>
+	BOREALIS_API void ResetJobCosts();
+}
@@ -0,0 +1,196 @@
+#include "job-io.h"
+#include "job-system.h"
+
+#include <assert.h>
+#include <atomic>
+#include <mutex>
+
+namespace Borealis::Jobs
+{
+	// ------------------ IO data ------------------
+	HANDLE g_ioPort = NULL;
+	std::atomic<int> g_pendingIoRequests(0);
+
+	// The port is shared by all schedulers, since a file can be used by jobs of any of them.
+	int g_ioPortUsers = 0;
+	std::mutex g_ioPortMutex{};
+
+	/// <summary>
+	/// Describes a single in-flight overlapped request. The OVERLAPPED structure has to be the first member
+	/// so a completion entry can be mapped back to its request.
+	/// </summary>
+	struct IoRequest
+	{
+		OVERLAPPED m_Overlapped{};
+		Counter m_Counter = Counter(1);
+
+		IoRequest(const unsigned long long offset)
+		{
+			m_Overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+			m_Overlapped.OffsetHigh = (DWORD)(offset >> 32);
+		}
+	};
+
+	/// <summary>
+	/// Creates the completion port all asynchronous file requests are reported to, if this is the first scheduler using it.
+	/// </summary>
+	void CreateIoPort()
+	{
+		std::lock_guard<std::mutex> lock(g_ioPortMutex);
+
+		if (g_ioPortUsers++ > 0)
+			return;
+
+		g_ioPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 0);
+		assert(g_ioPort != NULL);
+	}
+
+	/// <summary>
+	/// Closes the completion port once the last scheduler using it is gone.
+	/// Outstanding requests are not reaped anymore after this call!
+	/// </summary>
+	void DestroyIoPort()
+	{
+		std::lock_guard<std::mutex> lock(g_ioPortMutex);
+
+		if (g_ioPortUsers == 0 || --g_ioPortUsers > 0)
+			return;
+
+		if (g_ioPort != NULL)
+		{
+			CloseHandle(g_ioPort);
+			g_ioPort = NULL;
+		}
+
+		g_pendingIoRequests.store(0, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Reaps finished requests from the completion port without blocking and decrements their counters,
+	/// which makes the waiting fibers runnable again through the wait list.
+	/// </summary>
+	void PollIoCompletions()
+	{
+		// Avoid the syscall entirely as long as nobody is waiting on IO
+		if (g_pendingIoRequests.load(std::memory_order_relaxed) == 0)
+			return;
+
+		OVERLAPPED_ENTRY entries[MAX_IO_COMPLETIONS_PER_POLL()];
+		ULONG count = 0;
+
+		if (!GetQueuedCompletionStatusEx(g_ioPort, entries, MAX_IO_COMPLETIONS_PER_POLL(), &count, 0, FALSE))
+			return;
+
+		for (ULONG i = 0; i < count; ++i)
+		{
+			IoRequest* request = reinterpret_cast<IoRequest*>(entries[i].lpOverlapped);
+			g_pendingIoRequests.fetch_sub(1, std::memory_order_relaxed);
+
+			// The request lives on the waiting fiber's stack and must not be touched after this!
+			request->m_Counter.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	/// <summary>
+	/// Returns the amount of issued requests whose completions were not reaped yet.
+	/// </summary>
+	int GetNumPendingIoRequests()
+	{
+		return g_pendingIoRequests.load(std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Parks the calling fiber until the issued request completed and collects its result.
+	/// </summary>
+	/// <param name="file">The file the request was issued on.</param>
+	/// <param name="request">The issued request.</param>
+	/// <param name="issued">The return value of ReadFile / WriteFile.</param>
+	/// <param name="pBytes">Optional out parameter receiving the amount of bytes transferred.</param>
+	/// <returns>True if the request succeeded.</returns>
+	static bool WaitForIoRequest(HANDLE file, IoRequest& request, const BOOL issued, unsigned long* pBytes)
+	{
+		if (!issued && GetLastError() != ERROR_IO_PENDING)
+		{
+			// Failed immediately -> No completion will ever be posted for this request.
+			g_pendingIoRequests.fetch_sub(1, std::memory_order_relaxed);
+
+			if (pBytes != nullptr)
+				*pBytes = 0;
+
+			return false;
+		}
+
+		WaitForSignal(&request.m_Counter);
+
+		DWORD bytes = 0;
+		const BOOL success = GetOverlappedResult(file, &request.m_Overlapped, &bytes, FALSE);
+
+		if (pBytes != nullptr)
+			*pBytes = bytes;
+
+		return success != FALSE;
+	}
+
+	/// <summary>
+	/// Opens a file for asynchronous (overlapped) access and registers it with the job system's completion port.
+	/// </summary>
+	/// <param name="path">The path of the file to open.</param>
+	/// <param name="write">Whether the file should be created / truncated and opened for writing instead of reading.</param>
+	/// <returns>The file handle or INVALID_HANDLE_VALUE on failure.</returns>
+	HANDLE OpenAsyncFile(const char* path, const bool write)
+	{
+		HANDLE file = CreateFileA(path,
+			write ? GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ,
+			NULL,
+			write ? CREATE_ALWAYS : OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+			NULL);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return file;
+
+		if (!RegisterAsyncFile(file))
+		{
+			CloseHandle(file);
+			return INVALID_HANDLE_VALUE;
+		}
+
+		return file;
+	}
+
+	/// <summary>
+	/// Registers an overlapped file handle with the job system's completion port.
+	/// </summary>
+	/// <param name="file">The overlapped file handle.</param>
+	/// <returns>True if the handle was associated with the completion port.</returns>
+	bool RegisterAsyncFile(HANDLE file)
+	{
+		assert(g_ioPort != NULL && "The job system has to be initialized before registering files!");
+		return CreateIoCompletionPort(file, g_ioPort, 0, 0) == g_ioPort;
+	}
+
+	/// <summary>
+	/// Reads from the file and parks the calling fiber until the read completed.
+	/// </summary>
+	bool AsyncRead(HANDLE file, void* buffer, const unsigned long size, const unsigned long long offset, unsigned long* pBytesRead)
+	{
+		IoRequest request(offset);
+		g_pendingIoRequests.fetch_add(1, std::memory_order_relaxed);
+
+		const BOOL issued = ReadFile(file, buffer, size, NULL, &request.m_Overlapped);
+		return WaitForIoRequest(file, request, issued, pBytesRead);
+	}
+
+	/// <summary>
+	/// Writes to the file and parks the calling fiber until the write completed.
+	/// </summary>
+	bool AsyncWrite(HANDLE file, const void* buffer, const unsigned long size, const unsigned long long offset, unsigned long* pBytesWritten)
+	{
+		IoRequest request(offset);
+		g_pendingIoRequests.fetch_add(1, std::memory_order_relaxed);
+
+		const BOOL issued = WriteFile(file, buffer, size, NULL, &request.m_Overlapped);
+		return WaitForIoRequest(file, request, issued, pBytesWritten);
+	}
+}
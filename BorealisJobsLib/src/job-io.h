@@ -0,0 +1,59 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#error The Borealis job system is currently only available for Windows.
+#endif
+
+namespace Borealis::Jobs
+{
+	/// <summary>
+	/// Opens a file for asynchronous (overlapped) access and registers it with the job system's completion port.
+	/// Only files opened through this function (or registered via RegisterAsyncFile) can be used with AsyncRead / AsyncWrite.
+	/// </summary>
+	/// <param name="path">The path of the file to open.</param>
+	/// <param name="write">Whether the file should be created / truncated and opened for writing instead of reading.</param>
+	/// <returns>The file handle or INVALID_HANDLE_VALUE on failure. Close it with CloseHandle.</returns>
+	BOREALIS_API HANDLE OpenAsyncFile(const char* path, const bool write = false);
+
+	/// <summary>
+	/// Registers a file handle which was opened with FILE_FLAG_OVERLAPPED with the job system's completion port.
+	/// </summary>
+	/// <param name="file">The overlapped file handle.</param>
+	/// <returns>True if the handle was associated with the completion port.</returns>
+	BOREALIS_API bool RegisterAsyncFile(HANDLE file);
+
+	/// <summary>
+	/// Reads from the file without blocking the worker thread. The calling fiber is parked like in WaitForCounter
+	/// and made runnable again once a worker reaps the completion. Must be called from within a job or the main fiber.
+	/// </summary>
+	/// <param name="file">A file handle opened via OpenAsyncFile.</param>
+	/// <param name="buffer">The destination buffer.</param>
+	/// <param name="size">The amount of bytes to read.</param>
+	/// <param name="offset">The file offset to start reading from.</param>
+	/// <param name="pBytesRead">Optional out parameter receiving the amount of bytes actually read.</param>
+	/// <returns>True if the read succeeded.</returns>
+	BOREALIS_API bool AsyncRead(HANDLE file, void* buffer, const unsigned long size, const unsigned long long offset = 0, unsigned long* pBytesRead = nullptr);
+
+	/// <summary>
+	/// Writes to the file without blocking the worker thread. The calling fiber is parked like in WaitForCounter
+	/// and made runnable again once a worker reaps the completion. Must be called from within a job or the main fiber.
+	/// </summary>
+	/// <param name="file">A file handle opened via OpenAsyncFile.</param>
+	/// <param name="buffer">The source buffer.</param>
+	/// <param name="size">The amount of bytes to write.</param>
+	/// <param name="offset">The file offset to start writing at.</param>
+	/// <param name="pBytesWritten">Optional out parameter receiving the amount of bytes actually written.</param>
+	/// <returns>True if the write succeeded.</returns>
+	BOREALIS_API bool AsyncWrite(HANDLE file, const void* buffer, const unsigned long size, const unsigned long long offset = 0, unsigned long* pBytesWritten = nullptr);
+
+	// --------------------------------------------------------
+
+	void CreateIoPort();
+	void DestroyIoPort();
+	void PollIoCompletions();
+	int GetNumPendingIoRequests();
+}
@@ -0,0 +1,221 @@
+#include "job-pipeline.h"
+#include "job-system.h"
+#include "scoped-spinlock.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <utility>
+
+namespace Borealis::Jobs
+{
+	/// <summary>
+	/// A single stage of a pipeline including the state needed to serialize it.
+	/// </summary>
+	struct PipelineStage
+	{
+		StageMode m_Mode = StageMode::PARALLEL;
+		PipelineStageFunction m_Function{};
+
+		// SERIAL_OUT_OF_ORDER: Only one token inside the stage
+		JobMutex m_Mutex{};
+
+		// SERIAL_IN_ORDER: The sequence number allowed to enter next and the parked tokens waiting for their turn
+		SpinLock m_OrderLock{};
+		unsigned long long m_NextSequence = 0;
+		std::vector<std::pair<unsigned long long, JobWaitNode*>> m_Waiting{};
+	};
+
+	Pipeline::Pipeline(const int maxTokens, const Priority priority, std::string tokenName)
+		: m_MaxTokens(std::max(maxTokens, 1))
+		, m_Priority(priority)
+		, m_TokenName(std::move(tokenName))
+	{
+		assert(maxTokens < NUM_FIBERS() && "Every waiting token occupies a fiber!");
+	}
+
+	Pipeline::~Pipeline()
+	{
+		for (PipelineStage* stage : m_Stages)
+		{
+			delete stage;
+		}
+	}
+
+	/// <summary>
+	/// Sets the function producing the items. The source is always called serially and defines the item order.
+	/// </summary>
+	Pipeline& Pipeline::SetSource(PipelineSource source)
+	{
+		m_Source = std::move(source);
+		return *this;
+	}
+
+	/// <summary>
+	/// Appends a stage. The stages are run in the order they were added.
+	/// </summary>
+	Pipeline& Pipeline::AddStage(const StageMode mode, PipelineStageFunction function)
+	{
+		PipelineStage* stage = new PipelineStage();
+		stage->m_Mode = mode;
+		stage->m_Function = std::move(function);
+
+		m_Stages.push_back(stage);
+		return *this;
+	}
+
+	int Pipeline::GetMaxTokens() const
+	{
+		return m_MaxTokens;
+	}
+
+	void Pipeline::Run()
+	{
+		assert(m_Source && "The pipeline has no source!");
+
+		m_SourceEnded = false;
+		m_NextSequence = 0;
+
+		for (PipelineStage* stage : m_Stages)
+		{
+			stage->m_NextSequence = 0;
+			stage->m_Waiting.clear();
+		}
+
+		m_ActiveTokens.store(m_MaxTokens, std::memory_order_relaxed);
+
+		std::vector<Job> tokens;
+		tokens.reserve(m_MaxTokens);
+
+		for (int i = 0; i < m_MaxTokens; ++i)
+		{
+			tokens.emplace_back([this](uintptr_t) { RunToken(); }, &m_ActiveTokens, m_Priority, m_TokenName);
+		}
+
+		KickJobs(tokens.data(), m_MaxTokens);
+		WaitForCounter(&m_ActiveTokens);
+	}
+
+	/// <summary>
+	/// Kicks a token job, which carries a single item through the pipeline.
+	/// </summary>
+	void Pipeline::KickToken()
+	{
+		KickJob(Job([this](uintptr_t) { RunToken(); }, &m_ActiveTokens, m_Priority, m_TokenName));
+	}
+
+	/// <summary>
+	/// Pulls the next item, runs it through all stages and re-kicks the token for the next item. In between,
+	/// the worker is free to run other jobs. Once the source ended, the token retires.
+	/// </summary>
+	void Pipeline::RunToken()
+	{
+		void* item = nullptr;
+		unsigned long long sequence = 0;
+
+		if (!PullItem(item, sequence))
+			return;
+
+		for (PipelineStage* stage : m_Stages)
+		{
+			RunStage(*stage, item, sequence);
+		}
+
+		// Keep the pipeline alive before this job signals its counter
+		m_ActiveTokens.fetch_add(1, std::memory_order_relaxed);
+		KickToken();
+	}
+
+	/// <summary>
+	/// Pulls the next item from the source and assigns its sequence number.
+	/// </summary>
+	/// <returns>False if the stream ended.</returns>
+	bool Pipeline::PullItem(void*& item, unsigned long long& sequence)
+	{
+		ScopedJobLock lock(m_SourceMutex);
+
+		if (m_SourceEnded)
+			return false;
+
+		if (!m_Source(item))
+		{
+			m_SourceEnded = true;
+			return false;
+		}
+
+		sequence = m_NextSequence++;
+		return true;
+	}
+
+	/// <summary>
+	/// Runs the item through the stage according to its mode. Dropped items (nullptr) are only passed
+	/// through the serial in-order stages to take their turn, so the tokens behind them are not blocked.
+	/// </summary>
+	void Pipeline::RunStage(PipelineStage& stage, void*& item, const unsigned long long sequence)
+	{
+		switch (stage.m_Mode)
+		{
+			case StageMode::PARALLEL:
+			{
+				if (item != nullptr)
+					item = stage.m_Function(item);
+
+				break;
+			}
+			case StageMode::SERIAL_OUT_OF_ORDER:
+			{
+				if (item != nullptr)
+				{
+					ScopedJobLock lock(stage.m_Mutex);
+					item = stage.m_Function(item);
+				}
+
+				break;
+			}
+			case StageMode::SERIAL_IN_ORDER:
+			{
+				JobWaitNode node;
+				bool mustWait = false;
+
+				{
+					ScopedSpinLock lock(stage.m_OrderLock);
+
+					if (stage.m_NextSequence != sequence)
+					{
+						stage.m_Waiting.emplace_back(sequence, &node);
+						mustWait = true;
+					}
+				}
+
+				// Parked until the token in front of us left the stage
+				if (mustWait)
+					WaitForSignal(&node.m_Counter);
+
+				if (item != nullptr)
+					item = stage.m_Function(item);
+
+				JobWaitNode* next = nullptr;
+
+				{
+					ScopedSpinLock lock(stage.m_OrderLock);
+					++stage.m_NextSequence;
+
+					auto it = std::find_if(stage.m_Waiting.begin(), stage.m_Waiting.end(),
+						[&stage](const std::pair<unsigned long long, JobWaitNode*>& waiting) { return waiting.first == stage.m_NextSequence; });
+
+					if (it != stage.m_Waiting.end())
+					{
+						next = it->second;
+						*it = stage.m_Waiting.back();
+						stage.m_Waiting.pop_back();
+					}
+				}
+
+				// The node lives on the resumed fiber's stack and must not be touched afterwards!
+				if (next != nullptr)
+					next->m_Counter.store(0, std::memory_order_release);
+
+				break;
+			}
+		}
+	}
+}
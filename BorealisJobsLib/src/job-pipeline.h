@@ -0,0 +1,79 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+#include "job-sync.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Borealis::Jobs
+{
+	enum class StageMode : short
+	{
+		PARALLEL = 0,				// Any amount of tokens run the stage concurrently
+		SERIAL_IN_ORDER = 1,		// One token at a time, in the order the source produced the items
+		SERIAL_OUT_OF_ORDER = 2,	// One token at a time, in any order
+	};
+
+	// Produces the next item of the stream. Returns false once the stream ended.
+	typedef std::function<bool(void*& item)> PipelineSource;
+
+	// Processes an item and returns the item handed to the next stage. Returning nullptr drops the item.
+	typedef std::function<void*(void* item)> PipelineStageFunction;
+
+	struct PipelineStage;
+
+	/// <summary>
+	/// A bounded streaming pipeline running on the workers of the current scheduler. Items are pulled from a serial source
+	/// and carried through the stages by at most maxTokens tokens, so the memory held by in-flight items stays bounded
+	/// while parallel stages scale with the cores. Every token is a job processing a single item and re-kicking itself
+	/// afterwards, so the pipeline never monopolizes the workers. Tokens waiting for a serial stage park their fiber.
+	/// </summary>
+	class BOREALIS_API Pipeline
+	{
+	public:
+		/// <summary>
+		/// Creates an empty pipeline.
+		/// </summary>
+		/// <param name="maxTokens">The maximum amount of items in flight. Each waiting token occupies a fiber,
+		/// so this should stay well below NUM_FIBERS.</param>
+		/// <param name="priority">The priority the token jobs are kicked with.</param>
+		/// <param name="tokenName">The function name of the token jobs, under which the job cost model learns their costs.
+		/// Pipelines with stages of different costs should use different names.</param>
+		explicit Pipeline(const int maxTokens, const Priority priority = Priority::NORMAL, std::string tokenName = "PipelineToken");
+		~Pipeline();
+
+		Pipeline(const Pipeline&) = delete;
+		Pipeline& operator=(const Pipeline&) = delete;
+
+		Pipeline& SetSource(PipelineSource source);
+		Pipeline& AddStage(const StageMode mode, PipelineStageFunction function);
+
+		/// <summary>
+		/// Runs the pipeline until the source ended and every item left the last stage.
+		/// Parks the calling fiber in the meantime, so it has to be called from within a job or the main fiber.
+		/// </summary>
+		void Run();
+
+		int GetMaxTokens() const;
+
+	private:
+		void RunToken();
+		bool PullItem(void*& item, unsigned long long& sequence);
+		void RunStage(PipelineStage& stage, void*& item, const unsigned long long sequence);
+		void KickToken();
+
+		int m_MaxTokens = 1;
+		Priority m_Priority = Priority::NORMAL;
+		std::string m_TokenName{};
+
+		PipelineSource m_Source{};
+		JobMutex m_SourceMutex{};
+		bool m_SourceEnded = false;
+		unsigned long long m_NextSequence = 0;
+
+		std::vector<PipelineStage*> m_Stages{};
+		Counter m_ActiveTokens = Counter(0);
+	};
+}
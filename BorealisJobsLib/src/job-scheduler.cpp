@@ -0,0 +1,2082 @@
+#include "job-scheduler.h"
+#include "job-io.h"
+#include "job-cost-model.h"
+#include "sharded-counter.h"
+#include "scoped-spinlock.h"
+#include "spinlock.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <queue>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#error The Borealis job system is currently only available for Windows.
+#endif
+
+// Aligns the scheduler state written by different threads to cache lines of its own. Building with
+// BOREALIS_PACKED_SCHEDULER_LAYOUT packs the state instead, so the layout benchmark can compare both layouts.
+#ifdef BOREALIS_PACKED_SCHEDULER_LAYOUT
+#define BOREALIS_CACHE_ALIGNED
+#else
+#define BOREALIS_CACHE_ALIGNED alignas(CACHE_LINE_SIZE())
+#endif
+
+namespace Borealis::Jobs
+{
+	static constexpr int MAIN_THREAD_INDEX = 0;
+
+	// ------------------ Thread local data ------------------
+
+	// The scheduler the calling thread belongs to or nullptr for foreign threads.
+	thread_local JobScheduler* t_scheduler = nullptr;
+
+	// Index of the thread inside its scheduler: 0 for the main thread and 1..n for the workers.
+	thread_local int t_threadIndex = -1;
+
+	// The fiber we switched away from, which can only be returned to the pool once the switch happened.
+	thread_local LPVOID t_fiberToRelease = nullptr;
+
+	// The priority of the job the calling thread is executing, which is lent to the jobs it waits on.
+	// Outside of jobs there is no priority to inherit, which LOW represents.
+	thread_local Priority t_jobPriority = Priority::LOW;
+
+	// ------------------ Batching data ------------------
+
+	static constexpr double JOB_DURATION_SMOOTHING = 0.125;
+
+	// Moving average of the job durations observed by this thread, used to size the job batches.
+	thread_local double t_averageJobNs = JOB_BATCH_TARGET_NS();
+
+	// Counts the jobs executed by this thread, so every JOB_COST_SAMPLE_INTERVAL-th one is fed into the job cost model.
+	thread_local int t_jobCostSampleCounter = 0;
+
+	// ------------------ Wait data ------------------
+
+	struct WaitData
+	{
+		LPVOID m_Fiber = nullptr;
+		Counter* m_pCounter = nullptr;
+		int m_desiredCount = 0;
+		int m_ThreadIndex = MAIN_THREAD_INDEX;		// The thread the fiber prefers to be resumed on
+
+		WaitData()
+			: m_Fiber(nullptr), m_pCounter(nullptr), m_desiredCount(0), m_ThreadIndex(MAIN_THREAD_INDEX)
+		{ }
+
+		WaitData(const LPVOID _fiber, Counter* _counter, int desiredCount, const int threadIndex)
+			: m_Fiber(_fiber), m_pCounter(_counter), m_desiredCount(desiredCount), m_ThreadIndex(threadIndex)
+		{ }
+
+		~WaitData() = default;
+
+		bool operator !=(const WaitData& other)
+		{
+			return m_Fiber != other.m_Fiber;
+		}
+
+		bool operator ==(const WaitData& other)
+		{
+			return m_Fiber == other.m_Fiber;
+		}
+	};
+
+	// ------------------ Priority inheritance ------------------
+
+	/// <summary>
+	/// The lower priority jobs signalling a counter a more important job waits on. They are held here while proxies running
+	/// them sit in the job queues, so further waiters can lend them their priority by queueing further proxies instead of
+	/// searching the queues for them again.
+	/// </summary>
+	struct PendingSignallers
+	{
+		std::deque<Job> m_Jobs{};				// Not taken by any proxy yet
+		int m_NumProxies = 0;					// Queued proxies, each running one of the jobs if any is left
+		int m_NumWaiters = 0;
+		Priority m_Priority = Priority::LOW;	// The highest priority of the waiters, which the jobs inherit
+	};
+
+	// ------------------ Ready queues ------------------
+
+	/// <summary>
+	/// A fiber whose wait condition is met and which is ready to be switched to.
+	/// </summary>
+	struct ReadyFiber
+	{
+		LPVOID m_Fiber = nullptr;
+		std::chrono::steady_clock::time_point m_ReadySince{};
+	};
+
+	/// <summary>
+	/// The ready fibers of a single thread. Fibers are routed into the queue of the thread they suspended on
+	/// in order to keep their data cache-warm. The main thread's queue is never stolen from.
+	/// Every queue is polled by its own thread in every iteration and therefore gets its own cache line.
+	/// </summary>
+	struct BOREALIS_CACHE_ALIGNED ReadyQueue
+	{
+		SpinLock m_Lock{};
+		std::atomic<int> m_Count = 0;
+		std::deque<ReadyFiber> m_Fibers{};
+	};
+
+	// ------------------ Job queues ------------------
+
+	/// <summary>
+	/// A job queue and the lock guarding it. Every queue gets cache lines of its own, so kicking jobs of one priority
+	/// doesn't invalidate the lines the consumers of another priority are polling.
+	/// </summary>
+	struct BOREALIS_CACHE_ALIGNED JobQueue
+	{
+		// The queues are hammered by every worker -> use fair ticket locks
+		TicketSpinLock m_Lock{};
+		std::deque<Job> m_Jobs{};
+	};
+
+	// ------------------ Fiber data ------------------
+
+	/// <summary>
+	/// The batch of jobs a fiber took from a single queue. Lives in the fiber's data instead of on its stack, so the jobs
+	/// not executed yet can be handed back to their queue when a job of the batch parks the fiber.
+	/// </summary>
+	struct JobBatch
+	{
+		Job m_Jobs[MAX_JOB_BATCH_SIZE()];
+		JobQueue* m_pQueue = nullptr;
+		int m_Count = 0;
+		int m_Next = 0;
+
+		// Time the jobs of the batch spent parked, which is excluded from the batch statistics
+		std::chrono::nanoseconds m_ParkedTime{};
+	};
+
+	/// <summary>
+	/// The data of a pooled fiber, passed as its fiber parameter.
+	/// </summary>
+	struct FiberData
+	{
+		JobScheduler* m_pScheduler = nullptr;
+		JobBatch m_Batch{};
+		int m_ResumeThreadIndex = -1;		// The thread a parking job resumes on, -1 for the thread it parked on
+	};
+
+	// ------------------ Worker slots ------------------
+
+	static constexpr int WORKER_FREE = 0;
+	static constexpr int WORKER_ACTIVE = 1;
+	static constexpr int WORKER_RETIRING = 2;
+
+	/// <summary>
+	/// A worker thread slot. Slots are preallocated for the maximum amount of workers, so their index can be used
+	/// for the ready queues while elastic workers come and go. Every slot is only written by its own worker
+	/// and the scaling thread, hence it gets its own cache line.
+	/// </summary>
+	struct BOREALIS_CACHE_ALIGNED WorkerSlot
+	{
+		std::thread* m_pThread = nullptr;
+		std::atomic<int> m_State = WORKER_FREE;
+
+		// Published by the worker after every batch for the scaling decisions
+		std::atomic<double> m_AverageJobNs = JOB_BATCH_TARGET_NS();
+		std::atomic<long long> m_BusyNs = 0;
+	};
+
+	// ------------------ Scheduler data ------------------
+
+	/// <summary>
+	/// The complete state of a single scheduler instance. The state is grouped by access pattern and every group
+	/// starts on a cache line of its own: The read-mostly flags polled by every worker in every iteration never share
+	/// a line with a lock or a container written while scheduling, and independent locks never share a line either.
+	/// </summary>
+	struct SchedulerData
+	{
+		// ---------- Read-mostly: Only written while initializing, scaling or by the setters ----------
+
+		BOREALIS_CACHE_ALIGNED std::atomic<bool> m_RunThreads = false;
+		bool m_Initialized = false;
+		bool m_HasMainThread = false;
+
+		// Without worker threads, jobs are executed inline by the waiting thread. No fibers or threads are created.
+		bool m_SerialMode = false;
+		int m_SerialWaitDepth = 0;		// Nested waits of the main thread in serial mode
+
+		std::thread::id m_MainThreadId{};
+		LPVOID m_MainFiber = nullptr;
+
+		// Batching data
+		std::atomic<int> m_MaxJobBatchSize = MAX_JOB_BATCH_SIZE();
+
+		// Main thread stealing budget
+		std::atomic<long long> m_MainThreadStealBudgetNs = MAIN_THREAD_STEAL_BUDGET_US() * 1000ll;
+
+		bool m_PriorityInheritance = true;
+
+		// Worker data. The amount of workers moves between the minimum and maximum if the scheduler is elastic.
+		// The slots and ready queues are allocated once, so only their elements are written afterwards.
+		std::atomic<int> m_NumWorkers = 0;
+		int m_MinWorkers = 0;
+		int m_MaxWorkers = 0;
+		unsigned long long m_AffinityMask = 0;
+		std::vector<WorkerSlot> m_WorkerSlots{};
+
+		// One ready queue for the main thread and one for each worker
+		std::vector<ReadyQueue> m_ReadyQueues{};
+
+		// Scaling data. The sample counts are only touched by whoever drives the scaling.
+		std::thread* m_pScalingThread = nullptr;
+		ScalingCallback m_ScalingCallback{};
+		int m_PressureSamples = 0;
+		int m_IdleSamples = 0;
+
+		// ---------- Job queues ----------
+
+		JobQueue m_JobQueueHigh{};
+		JobQueue m_JobQueueNormal{};
+		JobQueue m_JobQueueLow{};
+		JobQueue m_MainThreadJobQueue{};
+
+		// ---------- Fiber pool: Written on every suspension and resumption ----------
+
+		BOREALIS_CACHE_ALIGNED TicketSpinLock m_FiberPoolLock{};
+		std::queue<LPVOID> m_FiberPool{};
+		std::vector<std::unique_ptr<FiberData>> m_FiberData{};
+
+		// ---------- Wait data ----------
+
+		BOREALIS_CACHE_ALIGNED SpinLock m_WaitListLock{};
+		std::atomic<int> m_NumWaitingFibers = 0;
+		std::vector<WaitData> m_WaitList{};
+
+		BOREALIS_CACHE_ALIGNED SpinLock m_ScheduleListLock{};
+		std::unordered_map<LPVOID, WaitData> m_ScheduleList{};
+
+		// ---------- Priority inheritance: Only written when jobs kick lower priority jobs or wait on their counters ----------
+
+		BOREALIS_CACHE_ALIGNED SpinLock m_PendingSignallersLock{};
+		std::atomic<int> m_NumBoostedWaits = 0;		// Polled by every kick before taking the lock
+		std::unordered_map<Counter*, PendingSignallers> m_PendingSignallers{};
+
+		// ---------- Thread fibers: Only written when workers start or terminate ----------
+
+		BOREALIS_CACHE_ALIGNED SpinLock m_ThreadFibersLock{};
+		std::unordered_map<std::thread::id, LPVOID> m_ThreadFibers{};
+	};
+
+	// ------------------ Thread local accessors ------------------
+
+	/// <summary>
+	/// Returns the scheduler the calling thread belongs to. Never inlined, since a fiber might
+	/// continue on another thread and must not reuse a cached thread local address.
+	/// </summary>
+	static __declspec(noinline) JobScheduler* GetThreadScheduler()
+	{
+		return t_scheduler;
+	}
+
+	/// <summary>
+	/// Binds the calling thread to the given scheduler.
+	/// </summary>
+	static __declspec(noinline) void SetThreadScheduler(JobScheduler* const scheduler, const int threadIndex)
+	{
+		t_scheduler = scheduler;
+		t_threadIndex = threadIndex;
+	}
+
+	/// <summary>
+	/// Returns the index of the calling thread inside its scheduler. Never inlined for the same reason as above.
+	/// </summary>
+	static __declspec(noinline) int GetThreadIndex()
+	{
+		return t_threadIndex;
+	}
+
+	/// <summary>
+	/// Remembers the fiber we are about to switch away from, so it gets returned to the pool after the switch.
+	/// </summary>
+	static __declspec(noinline) void SetFiberToRelease(const LPVOID fiber)
+	{
+		assert(t_fiberToRelease == nullptr);
+		t_fiberToRelease = fiber;
+	}
+
+	/// <summary>
+	/// Takes the fiber we just switched away from, if there is one.
+	/// </summary>
+	static __declspec(noinline) LPVOID TakeFiberToRelease()
+	{
+		LPVOID fiber = t_fiberToRelease;
+		t_fiberToRelease = nullptr;
+		return fiber;
+	}
+
+	/// <summary>
+	/// Returns the priority of the job the calling thread is executing. Never inlined for the same reason as above.
+	/// </summary>
+	static __declspec(noinline) Priority GetJobPriority()
+	{
+		return t_jobPriority;
+	}
+
+	/// <summary>
+	/// Sets the priority of the job the calling thread is executing.
+	/// </summary>
+	static __declspec(noinline) void SetJobPriority(const Priority priority)
+	{
+		t_jobPriority = priority;
+	}
+
+	/// <summary>
+	/// Feeds the duration of an executed batch into the moving average of the calling thread's job durations.
+	/// </summary>
+	/// <param name="count">The amount of jobs in the batch.</param>
+	/// <param name="elapsed">The time it took to execute the batch.</param>
+	static __declspec(noinline) void UpdateJobBatchStatistics(const int count, const std::chrono::nanoseconds elapsed)
+	{
+		const double sample = (double)elapsed.count() / count;
+		t_averageJobNs += (sample - t_averageJobNs) * JOB_DURATION_SMOOTHING;
+	}
+
+	/// <summary>
+	/// Returns the moving average of the calling thread's job durations.
+	/// </summary>
+	static __declspec(noinline) double GetAverageJobNs()
+	{
+		return t_averageJobNs;
+	}
+
+	/// <summary>
+	/// Returns whether the next job executed by the calling thread should be timed for the job cost model.
+	/// </summary>
+	static __declspec(noinline) bool ShouldSampleJobCost()
+	{
+		return ++t_jobCostSampleCounter % JOB_COST_SAMPLE_INTERVAL() == 0;
+	}
+
+	// ------------------ Helpers ------------------
+
+	/// <summary>
+	/// Pops up to maxCount jobs from the front of the queue under a single lock acquisition. Takes at most a fair share
+	/// of the queue, so the other consumers still find work.
+	/// </summary>
+	/// <param name="queue">The queue to pop from.</param>
+	/// <param name="jobs">The array receiving the jobs.</param>
+	/// <param name="maxCount">The maximum amount of jobs to pop.</param>
+	/// <param name="consumers">The amount of threads draining this queue.</param>
+	/// <returns>The amount of popped jobs.</returns>
+	static int PopJobs(JobQueue& queue, Job* const jobs, const int maxCount, const int consumers)
+	{
+		ScopedSpinLock lock(queue.m_Lock);
+
+		const int queueSize = (int)queue.m_Jobs.size();
+		const int fairShare = std::max(1, queueSize / std::max(1, consumers));
+		const int count = std::min({ maxCount, fairShare, queueSize });
+
+		for (int i = 0; i < count; ++i)
+		{
+			jobs[i] = std::move(queue.m_Jobs.front());
+			queue.m_Jobs.pop_front();
+		}
+
+		return count;
+	}
+
+	/// <summary>
+	/// Returns the queue jobs of the given priority are kicked to. Critical jobs share the high priority queue.
+	/// </summary>
+	static JobQueue& GetJobQueue(SchedulerData& data, const Priority priority)
+	{
+		switch (priority)
+		{
+			case Priority::LOW:
+				return data.m_JobQueueLow;
+			case Priority::NORMAL:
+				return data.m_JobQueueNormal;
+			default:
+				return data.m_JobQueueHigh;
+		}
+	}
+
+	/// <summary>
+	/// Returns the data of the calling pooled fiber or nullptr for fibers converted from a thread.
+	/// </summary>
+	static FiberData* GetCurrentFiberData()
+	{
+		return static_cast<FiberData*>(GetFiberData());
+	}
+
+	/// <summary>
+	/// Pushes the jobs of the batch that were not executed yet back to the front of their queue in their original order,
+	/// so they neither wait for the parked fiber nor deadlock a job of the same batch waiting on them.
+	/// </summary>
+	/// <param name="batch">The batch of the fiber about to park.</param>
+	static void ReturnUnexecutedJobs(JobBatch& batch)
+	{
+		if (batch.m_Next >= batch.m_Count)
+			return;
+
+		{
+			ScopedSpinLock lock(batch.m_pQueue->m_Lock);
+			for (int i = batch.m_Count - 1; i >= batch.m_Next; --i)
+			{
+				batch.m_pQueue->m_Jobs.push_front(std::move(batch.m_Jobs[i]));
+				batch.m_Jobs[i] = Job();
+			}
+		}
+
+		batch.m_Count = batch.m_Next;
+	}
+
+	/// <summary>
+	/// Returns the counter a job signals once it's done or nullptr if there is none.
+	/// </summary>
+	static Counter* GetSignalledCounter(const Job& job)
+	{
+		if (job.m_pShardedCounter != nullptr)
+			return job.m_pShardedCounter->GetRoot();
+
+		return job.m_pCounter;
+	}
+
+	/// <summary>
+	/// Moves the jobs signalling the counter out of the last PRIORITY_INHERITANCE_SCAN_DEPTH jobs of the queue, keeping
+	/// their order.
+	/// </summary>
+	/// <param name="queue">The queue to search.</param>
+	/// <param name="cnt">The counter the jobs signal.</param>
+	/// <param name="jobs">The list receiving the jobs.</param>
+	/// <param name="maxCount">The amount of jobs after which the search stops.</param>
+	/// <returns>The amount of jobs moved.</returns>
+	static int TakeQueuedSignallers(JobQueue& queue, Counter* const cnt, std::deque<Job>& jobs, const int maxCount)
+	{
+		ScopedSpinLock lock(queue.m_Lock);
+
+		const int depth = std::min((int)queue.m_Jobs.size(), PRIORITY_INHERITANCE_SCAN_DEPTH());
+		const size_t insertAt = jobs.size();
+		int count = 0;
+
+		for (int i = 0; i < depth && count < maxCount; ++i)
+		{
+			auto it = queue.m_Jobs.end() - 1 - (i - count);
+			if (GetSignalledCounter(*it) != cnt)
+				continue;
+
+			jobs.insert(jobs.begin() + insertAt, std::move(*it));
+			queue.m_Jobs.erase(it);
+			++count;
+		}
+
+		return count;
+	}
+
+	/// <summary>
+	/// Executes the job on the current fiber and signals its counter.
+	/// </summary>
+	/// <param name="job">The job to be executed.</param>
+	static void ExecuteJob(Job& job)
+	{
+		// Jobs run nested when executed inline or while waiting in serial mode
+		const Priority outerPriority = GetJobPriority();
+		SetJobPriority(job.m_Priority);
+
+		job.m_Fiber = GetCurrentFiber();
+		job.m_EntryPoint(job.m_Param);
+
+		SetJobPriority(outerPriority);
+
+		// We might not want to associate a counter with a parallel job!
+		if (job.m_pCounter != nullptr)
+		{
+			job.m_pCounter->fetch_sub(1);
+		}
+		else if (job.m_pShardedCounter != nullptr)
+		{
+			job.m_pShardedCounter->Decrement();
+		}
+
+		job.m_Fiber = nullptr;
+	}
+
+	/// <summary>
+	/// Executes the job like ExecuteJob and records the execution time of every JOB_COST_SAMPLE_INTERVAL-th named job
+	/// in the job cost model. The time the job spent parked is not part of its cost.
+	/// </summary>
+	/// <param name="job">The job to be executed.</param>
+	static void ExecuteAndSampleJob(Job& job)
+	{
+		if (job.m_FunctionName.empty() || !ShouldSampleJobCost())
+		{
+			ExecuteJob(job);
+			return;
+		}
+
+		// Fibers converted from a thread run jobs serially and never park. The batch keeps its own parked time total.
+		FiberData* const fiberData = GetCurrentFiberData();
+		const std::chrono::nanoseconds parkedBefore = fiberData != nullptr ? fiberData->m_Batch.m_ParkedTime : std::chrono::nanoseconds::zero();
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		ExecuteJob(job);
+
+		std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+		if (fiberData != nullptr)
+			elapsed -= fiberData->m_Batch.m_ParkedTime - parkedBefore;
+
+		RecordJobCost(job.m_FunctionName, (double)elapsed.count());
+	}
+
+	/// <summary>
+	/// Returns the learned execution time of the job or the given fallback for job types that were never recorded.
+	/// </summary>
+	static double EstimateJobNs(const Job& job, const double fallbackNs)
+	{
+		double estimateNs = fallbackNs;
+		GetJobCostEstimate(job.m_FunctionName, estimateNs);
+		return estimateNs;
+	}
+
+	// ------------------ JobScheduler ------------------
+
+	JobScheduler::JobScheduler()
+		: m_pData(new SchedulerData())
+	{ }
+
+	JobScheduler::~JobScheduler()
+	{
+		if (m_pData->m_Initialized)
+			Deinitialize();
+
+		delete m_pData;
+	}
+
+	/// <summary>
+	/// Returns the default scheduler, which is driven by InitializeJobSystem and the free functions.
+	/// </summary>
+	JobScheduler& JobScheduler::Default()
+	{
+		static JobScheduler s_defaultScheduler;
+		return s_defaultScheduler;
+	}
+
+	/// <summary>
+	/// Returns the scheduler owning the calling thread or the default scheduler for foreign threads.
+	/// </summary>
+	JobScheduler& JobScheduler::Current()
+	{
+		JobScheduler* scheduler = GetThreadScheduler();
+		return scheduler != nullptr ? *scheduler : Default();
+	}
+
+	bool JobScheduler::IsInitialized() const
+	{
+		return m_pData->m_Initialized;
+	}
+
+	int JobScheduler::GetNumWorkers() const
+	{
+		return m_pData->m_NumWorkers.load(std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Returns the amount of fibers currently available in the fiber pool. Fibers that are running or parked are not
+	/// counted, so an idle scheduler has exactly NUM_FIBERS minus one fiber per worker in its pool.
+	/// </summary>
+	int JobScheduler::GetNumPooledFibers() const
+	{
+		SchedulerData& data = *m_pData;
+
+		ScopedSpinLock lock(data.m_FiberPoolLock);
+		return (int)data.m_FiberPool.size();
+	}
+
+	/// <summary>
+	/// Initializes the scheduler.
+	/// </summary>
+	/// <param name="desc">The thread count, core mask and main thread behaviour of the scheduler. A thread count of 0
+	/// (or a single core machine) selects the serial mode, which runs all jobs inline on the main thread while it waits
+	/// without creating any fibers or threads. Schedulers not adopting the calling thread always get at least one worker.</param>
+	void JobScheduler::Initialize(const JobSchedulerDesc& desc)
+	{
+		SchedulerData& data = *m_pData;
+		assert(!data.m_Initialized && "The scheduler is already initialized!");
+		assert((!desc.m_AdoptCallingThread || GetThreadScheduler() == nullptr) && "The calling thread already belongs to a scheduler!");
+
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		int numOfThreads = desc.m_NumOfThreads;
+
+		// Define number of threads
+		if (numOfThreads < 0 || numOfThreads > hardwareThreads)
+			numOfThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+
+		// Without a main thread there is nobody to run the jobs inline
+		if (!desc.m_AdoptCallingThread)
+			numOfThreads = std::max(numOfThreads, 1);
+
+		// Elastic scaling never goes beyond the logical cores and is not available in serial mode
+		const int maxNumOfThreads = numOfThreads > 0 ? std::clamp(desc.m_MaxNumOfThreads, numOfThreads, std::max(numOfThreads, (int)hardwareThreads)) : 0;
+
+		printf("Number of logical cpu cores: %i\n", std::thread::hardware_concurrency());
+		printf("Number of worker threads: %i\n", numOfThreads);
+
+		if (maxNumOfThreads > numOfThreads)
+			printf("Maximum number of worker threads: %i\n", maxNumOfThreads);
+
+		data.m_Initialized = true;
+		data.m_HasMainThread = desc.m_AdoptCallingThread;
+		data.m_PriorityInheritance = desc.m_PriorityInheritance;
+
+		if (desc.m_AdoptCallingThread)
+		{
+			data.m_MainThreadId = std::this_thread::get_id();
+			SetThreadScheduler(this, MAIN_THREAD_INDEX);
+		}
+
+		if (numOfThreads == 0)
+		{
+			// No workers -> Run every job inline on the main thread without any fibers.
+			printf("Running job system in serial mode\n");
+
+			data.m_SerialMode = true;
+
+			CreateIoPort();
+			return;
+		}
+
+		// Store true to enable the infinite working routine on each thread
+		data.m_RunThreads.store(true, std::memory_order_relaxed);
+
+		data.m_MinWorkers = numOfThreads;
+		data.m_MaxWorkers = maxNumOfThreads;
+		data.m_AffinityMask = desc.m_AffinityMask;
+		data.m_ScalingCallback = desc.m_ScalingCallback;
+
+		CreateFiberPool(); // and reserve wait list to the maximum number of possible fibers
+		CreateIoPort();
+		CreateThreadPool(numOfThreads);
+
+		if (data.m_MaxWorkers > data.m_MinWorkers && desc.m_AutomaticScaling)
+			data.m_pScalingThread = new std::thread(&JobScheduler::RunScalingThread, this);
+
+		if (desc.m_AdoptCallingThread)
+			data.m_MainFiber = ConvertThreadToFiber(0);
+	}
+
+	/// <summary>
+	/// Deinitializes the scheduler and clears all the resources. Has to be called from the main thread
+	/// if the scheduler adopted it.
+	/// </summary>
+	void JobScheduler::Deinitialize()
+	{
+		SchedulerData& data = *m_pData;
+		printf("Deinitializing job system from thread %d\n", GetCurrentThreadId());
+
+		data.m_RunThreads.store(false, std::memory_order_release);
+
+		Sleep(1);
+
+		if (data.m_HasMainThread)
+		{
+			assert(std::this_thread::get_id() == data.m_MainThreadId);
+
+			if (IsThreadAFiber())
+				ConvertFiberToThread(); // @TODO: Which thread will this be and will it be joined soon?
+
+			SetThreadScheduler(nullptr, -1);
+		}
+
+		// Stop scaling before the workers are joined
+		if (data.m_pScalingThread != nullptr)
+		{
+			data.m_pScalingThread->join();
+			delete data.m_pScalingThread;
+			data.m_pScalingThread = nullptr;
+		}
+
+		// Join and clear the worker threads
+		{
+			for (WorkerSlot& slot : data.m_WorkerSlots)
+			{
+				std::thread* thread = slot.m_pThread;
+				if (thread == nullptr)
+					continue;
+
+				if (std::this_thread::get_id() != thread->get_id() && thread->joinable())
+				{
+					thread->join();
+				}
+
+				delete thread;
+			}
+
+			data.m_WorkerSlots.clear();
+		}
+
+		DestroyIoPort();
+
+		// Clear the fiber pool and delete all fibers in the pool
+		{
+			ScopedSpinLock lock(data.m_FiberPoolLock);
+			while (data.m_FiberPool.size() > 0)
+			{
+				LPVOID fiber = data.m_FiberPool.front();
+				data.m_FiberPool.pop();
+				DeleteFiber(fiber);
+			}
+		}
+
+		// Clear the wait list and delete all fibers in the wait list
+		{
+			ScopedSpinLock lock(data.m_WaitListLock);
+			for (int i = 0; i < data.m_WaitList.size(); ++i)
+			{
+				DeleteFiber(data.m_WaitList[i].m_Fiber);
+			}
+
+			data.m_WaitList.clear();
+			data.m_NumWaitingFibers.store(0, std::memory_order_relaxed);
+		}
+
+		// Delete all fibers that were ready but not resumed anymore
+		{
+			for (ReadyQueue& queue : data.m_ReadyQueues)
+			{
+				ScopedSpinLock lock(queue.m_Lock);
+				for (const ReadyFiber& readyFiber : queue.m_Fibers)
+				{
+					DeleteFiber(readyFiber.m_Fiber);
+				}
+			}
+
+			data.m_ReadyQueues.clear();
+		}
+
+		// Delete all scheduled fibers and clear the list
+		{
+			ScopedSpinLock lock(data.m_ScheduleListLock);
+			for (auto& kvp : data.m_ScheduleList)
+			{
+				DeleteFiber(kvp.second.m_Fiber);
+			}
+			data.m_ScheduleList.clear();
+		}
+
+		data.m_ThreadFibers.clear();
+		data.m_FiberData.clear();
+
+		// The proxies of the pending signallers were dropped with the queues
+		data.m_PendingSignallers.clear();
+		data.m_NumBoostedWaits.store(0, std::memory_order_relaxed);
+
+		data.m_JobQueueHigh.m_Jobs.clear();
+		data.m_JobQueueNormal.m_Jobs.clear();
+		data.m_JobQueueLow.m_Jobs.clear();
+		data.m_MainThreadJobQueue.m_Jobs.clear();
+
+		data.m_MainThreadId = std::thread::id();
+		data.m_MainFiber = nullptr;
+		data.m_NumWorkers.store(0, std::memory_order_relaxed);
+		data.m_MinWorkers = 0;
+		data.m_MaxWorkers = 0;
+		data.m_ScalingCallback = nullptr;
+		data.m_PressureSamples = 0;
+		data.m_IdleSamples = 0;
+		data.m_SerialMode = false;
+		data.m_HasMainThread = false;
+		data.m_Initialized = false;
+	}
+
+	/// <summary>
+	/// Forces the execution flow to be paused here and continued at the same point but by the main thread!
+	/// </summary>
+	void JobScheduler::ForceMainThreadExecution()
+	{
+		SchedulerData& data = *m_pData;
+		assert(data.m_HasMainThread && "The scheduler has no main thread!");
+
+		if (std::this_thread::get_id() == data.m_MainThreadId)
+			return;	// We are already on the main thread -> Early exit!
+
+		LPVOID fiber = GetFiber();
+		assert(fiber != nullptr);
+
+		const Priority priority = GetJobPriority();
+
+		// Already done, but has to stay alive until we got resumed!
+		Counter cnt = Counter(0);
+
+		// Schedule for wait list! Pinned to the main thread's ready queue.
+		{
+			ScopedSpinLock lock(data.m_ScheduleListLock);
+			data.m_ScheduleList.emplace(fiber, std::move(WaitData(GetCurrentFiber(), &cnt, 0, MAIN_THREAD_INDEX)));
+		}
+
+		ParkCurrentFiber(fiber);
+
+		// The main thread ran other jobs in meantime
+		SetJobPriority(priority);
+
+		printf("Continuing execution on thread %d\n", GetCurrentThreadId());
+	}
+
+	/// <summary>
+	/// Returns the next valid job that is available. Will prioritize as follows:
+	/// 1. Main thread jobs
+	/// 2. High priority jobs
+	/// 3. Normal priority jobs
+	/// 4. Low priority jobs
+	/// </summary>
+	/// <returns>TThe selected job from either of the four lists.</returns>
+	Job JobScheduler::GetNextJob()
+	{
+		Jobs::Job jobCpy;
+		GetNextJobs(&jobCpy, 1);
+		return jobCpy;
+	}
+
+	/// <summary>
+	/// Returns a batch of up to maxCount jobs of the same priority, taken from the first non-empty queue in the
+	/// same order as GetNextJob. The main thread only ever takes jobs from the main thread queue.
+	/// </summary>
+	/// <param name="jobs">The array receiving the jobs.</param>
+	/// <param name="maxCount">The maximum amount of jobs to take.</param>
+	/// <returns>The amount of jobs taken.</returns>
+	int JobScheduler::GetNextJobs(Job* const jobs, const int maxCount)
+	{
+		SchedulerData& data = *m_pData;
+
+		// MAIN THREAD queue
+		// Handle main thread jobs seperately!
+		if (data.m_HasMainThread && std::this_thread::get_id() == data.m_MainThreadId)
+			return PopJobs(data.m_MainThreadJobQueue, jobs, maxCount, 1);
+
+		return GetNextPriorityJobs(jobs, maxCount);
+	}
+
+	/// <summary>
+	/// Returns the next job from the priority queues, ignoring the main thread queue. Will prioritize as follows:
+	/// 1. High priority jobs
+	/// 2. Normal priority jobs
+	/// 3. Low priority jobs
+	/// </summary>
+	/// <returns>The selected job from either of the three lists.</returns>
+	Job JobScheduler::GetNextPriorityJob()
+	{
+		Jobs::Job jobCpy;
+		GetNextPriorityJobs(&jobCpy, 1);
+		return jobCpy;
+	}
+
+	/// <summary>
+	/// Returns a batch of up to maxCount jobs from the first non-empty priority queue.
+	/// </summary>
+	/// <param name="jobs">The array receiving the jobs.</param>
+	/// <param name="maxCount">The maximum amount of jobs to take.</param>
+	/// <returns>The amount of jobs taken.</returns>
+	int JobScheduler::GetNextPriorityJobs(Job* const jobs, const int maxCount)
+	{
+		SchedulerData& data = *m_pData;
+		const int numWorkers = data.m_NumWorkers.load(std::memory_order_relaxed);
+		int count = 0;
+
+		// HIGH Priority queue
+		if ((count = PopJobs(data.m_JobQueueHigh, jobs, maxCount, numWorkers)) > 0)
+			return count;
+
+		// NORMAL Priority queue
+		if ((count = PopJobs(data.m_JobQueueNormal, jobs, maxCount, numWorkers)) > 0)
+			return count;
+
+		// LOW Priority queue
+		return PopJobs(data.m_JobQueueLow, jobs, maxCount, numWorkers);
+	}
+
+	/// <summary>
+	/// Returns how many jobs the calling thread should take at once. Aims at batches running for about
+	/// JOB_BATCH_TARGET_NS based on the observed job durations, so tiny jobs amortize the scheduling overhead
+	/// while long jobs are still distributed one by one.
+	/// </summary>
+	int JobScheduler::GetJobBatchSize() const
+	{
+		const int maxBatchSize = m_pData->m_MaxJobBatchSize.load(std::memory_order_relaxed);
+		if (maxBatchSize <= 1)
+			return 1;
+
+		const double estimate = JOB_BATCH_TARGET_NS() / std::max(GetAverageJobNs(), 1.0);
+		return std::clamp((int)estimate, 1, maxBatchSize);
+	}
+
+	/// <summary>
+	/// Sets the maximum amount of jobs a worker takes from a queue at once. 1 disables batching.
+	/// </summary>
+	/// <param name="maxBatchSize">The maximum batch size. Clamped to [1, MAX_JOB_BATCH_SIZE].</param>
+	void JobScheduler::SetMaxJobBatchSize(const int maxBatchSize)
+	{
+		m_pData->m_MaxJobBatchSize.store(std::clamp(maxBatchSize, 1, MAX_JOB_BATCH_SIZE()), std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Sets how long the main thread may spend on jobs stolen from the worker queues before it checks its own fibers again.
+	/// </summary>
+	/// <param name="budget">The budget per stolen batch. 0 keeps the main thread on its own queue.</param>
+	void JobScheduler::SetMainThreadStealBudget(const std::chrono::microseconds budget)
+	{
+		const long long budgetNs = std::chrono::duration_cast<std::chrono::nanoseconds>(budget).count();
+		m_pData->m_MainThreadStealBudgetNs.store(std::max(budgetNs, 0ll), std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Pops jobs for the main thread from the first non-empty priority queue as long as their learned costs fit into the
+	/// budget. Stops in front of the first job that doesn't fit, which is left to the workers without reordering the queue.
+	/// </summary>
+	/// <param name="jobs">The array receiving the jobs.</param>
+	/// <param name="maxCount">The maximum amount of jobs to take.</param>
+	/// <param name="budgetNs">The time the jobs may take in total.</param>
+	/// <returns>The amount of jobs taken.</returns>
+	int JobScheduler::StealWorkerJobs(Job* const jobs, const int maxCount, const double budgetNs)
+	{
+		SchedulerData& data = *m_pData;
+		const int consumers = data.m_NumWorkers.load(std::memory_order_relaxed) + 1;
+		const double fallbackNs = GetAverageJobNs();
+
+		auto steal = [&](JobQueue& queue)
+		{
+			ScopedSpinLock lock(queue.m_Lock);
+
+			const int fairShare = std::max(1, (int)queue.m_Jobs.size() / consumers);
+			const int limit = std::min(maxCount, fairShare);
+			double totalNs = 0.0;
+			int count = 0;
+
+			while (count < limit && !queue.m_Jobs.empty())
+			{
+				totalNs += EstimateJobNs(queue.m_Jobs.front(), fallbackNs);
+				if (totalNs > budgetNs)
+					break;
+
+				jobs[count++] = std::move(queue.m_Jobs.front());
+				queue.m_Jobs.pop_front();
+			}
+
+			return count;
+		};
+
+		int count = 0;
+
+		if ((count = steal(data.m_JobQueueHigh)) > 0)
+			return count;
+
+		if ((count = steal(data.m_JobQueueNormal)) > 0)
+			return count;
+
+		return steal(data.m_JobQueueLow);
+	}
+
+	/// <summary>
+	/// Lets the waiting main thread execute a batch of worker jobs, so it contributes a full core during fan-ins.
+	/// Jobs can't be interrupted, hence only jobs whose learned costs fit into the steal budget are taken. Every stolen
+	/// job is timed, so a job type turning out to exceed the budget is not stolen again and the rest of the batch is
+	/// handed back to the workers once it reaches such a job. Stolen jobs that park resume on a worker, since the main
+	/// thread stops resuming fibers once its own fiber continues.
+	/// </summary>
+	void JobScheduler::RunStolenJobs()
+	{
+		SchedulerData& data = *m_pData;
+
+		const long long budgetNs = data.m_MainThreadStealBudgetNs.load(std::memory_order_relaxed);
+		if (budgetNs == 0)
+			return;
+
+		FiberData& fiberData = *GetCurrentFiberData();
+		JobBatch& batch = fiberData.m_Batch;
+		batch.m_Count = StealWorkerJobs(batch.m_Jobs, GetJobBatchSize(), (double)budgetNs);
+
+		if (batch.m_Count == 0)
+			return;
+
+		batch.m_pQueue = &GetJobQueue(data, batch.m_Jobs[0].m_Priority);
+
+		const int numWorkers = std::max(data.m_NumWorkers.load(std::memory_order_relaxed), 1);
+
+		for (batch.m_Next = 0; batch.m_Next < batch.m_Count;)
+		{
+			// Keep the queue position of the job and everything behind it
+			if (EstimateJobNs(batch.m_Jobs[batch.m_Next], 0.0) > budgetNs)
+			{
+				ReturnUnexecutedJobs(batch);
+				break;
+			}
+
+			Job& job = batch.m_Jobs[batch.m_Next++];
+
+			batch.m_ParkedTime = std::chrono::nanoseconds::zero();
+			const std::chrono::steady_clock::time_point jobStart = std::chrono::steady_clock::now();
+
+			// Spread parking jobs over the active workers, the others steal them from there if needed
+			fiberData.m_ResumeThreadIndex = MAIN_THREAD_INDEX + 1 + batch.m_Next % numWorkers;
+			ExecuteJob(job);
+			fiberData.m_ResumeThreadIndex = -1;
+
+			const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - jobStart - batch.m_ParkedTime;
+			UpdateJobBatchStatistics(1, elapsed);
+			RecordJobCost(job.m_FunctionName, (double)elapsed.count());
+
+			job = Job();
+		}
+
+		batch.m_Count = 0;
+	}
+
+	/// <summary>
+	/// Moves every wait list entry whose counter reached its desired count into the ready queue of the thread
+	/// it suspended on. Scans the whole list so a ready entry is never blocked by entries in front of it.
+	/// </summary>
+	void JobScheduler::PromoteReadyFibers()
+	{
+		SchedulerData& data = *m_pData;
+
+		if (data.m_NumWaitingFibers.load(std::memory_order_relaxed) == 0)
+			return;
+
+		// Somebody else is already promoting (or pushing) -> Don't queue up behind them.
+		if (!data.m_WaitListLock.TryAcquire())
+			return;
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		auto remaining = data.m_WaitList.begin();
+
+		for (auto it = data.m_WaitList.begin(); it != data.m_WaitList.end(); ++it)
+		{
+			if (it->m_pCounter->load(std::memory_order_acquire) <= it->m_desiredCount)
+			{
+				ReadyQueue& queue = data.m_ReadyQueues[it->m_ThreadIndex];
+
+				ScopedSpinLock lock(queue.m_Lock);
+				queue.m_Fibers.push_back(ReadyFiber{ it->m_Fiber, now });
+				queue.m_Count.fetch_add(1, std::memory_order_release);
+			}
+			else
+			{
+				*remaining++ = std::move(*it);
+			}
+		}
+
+		const int promoted = (int)(data.m_WaitList.end() - remaining);
+		data.m_WaitList.erase(remaining, data.m_WaitList.end());
+		data.m_NumWaitingFibers.fetch_sub(promoted, std::memory_order_relaxed);
+
+		data.m_WaitListLock.Release();
+	}
+
+	/// <summary>
+	/// Pops a fiber from the ready queue of the given thread. Workers may steal from other workers
+	/// if a fiber waited for its preferred thread longer than the steal threshold.
+	/// </summary>
+	/// <param name="threadIndex">The index of the calling thread.</param>
+	/// <returns>The fiber to resume or nullptr if there is none.</returns>
+	LPVOID JobScheduler::PopReadyFiber(const int threadIndex)
+	{
+		SchedulerData& data = *m_pData;
+
+		// Own queue first
+		{
+			ReadyQueue& queue = data.m_ReadyQueues[threadIndex];
+
+			if (queue.m_Count.load(std::memory_order_acquire) > 0)
+			{
+				ScopedSpinLock lock(queue.m_Lock);
+
+				if (!queue.m_Fibers.empty())
+				{
+					LPVOID fiber = queue.m_Fibers.front().m_Fiber;
+					queue.m_Fibers.pop_front();
+					queue.m_Count.fetch_sub(1, std::memory_order_relaxed);
+					return fiber;
+				}
+			}
+		}
+
+		// The main thread only ever resumes its own fibers
+		if (threadIndex == MAIN_THREAD_INDEX)
+			return nullptr;
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const int queueCount = (int)data.m_ReadyQueues.size();
+
+		for (int offset = 1; offset < queueCount; ++offset)
+		{
+			const int victim = (threadIndex + offset) % queueCount;
+			if (victim == MAIN_THREAD_INDEX)
+				continue;
+
+			ReadyQueue& queue = data.m_ReadyQueues[victim];
+
+			if (queue.m_Count.load(std::memory_order_acquire) == 0 || !queue.m_Lock.TryAcquire())
+				continue;
+
+			LPVOID fiber = nullptr;
+
+			if (!queue.m_Fibers.empty()
+				&& now - queue.m_Fibers.front().m_ReadySince > std::chrono::microseconds(READY_FIBER_STEAL_THRESHOLD_US()))
+			{
+				fiber = queue.m_Fibers.front().m_Fiber;
+				queue.m_Fibers.pop_front();
+				queue.m_Count.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			queue.m_Lock.Release();
+
+			if (fiber != nullptr)
+				return fiber;
+		}
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Promotes finished wait list entries into the ready queues and switches to the next ready fiber of this thread.
+	/// </summary>
+	void JobScheduler::CheckWaitList()
+	{
+		PromoteReadyFibers();
+
+		LPVOID fiberToSwitchTo = PopReadyFiber(GetThreadIndex());
+
+		if (fiberToSwitchTo == nullptr)
+			return;
+
+		// The current fiber must not be picked up by another thread before we actually switched away from it!
+		SetFiberToRelease(GetCurrentFiber());
+		SwitchToFiber(fiberToSwitchTo);
+		ReleasePendingFiber();
+
+		// This fiber might have been taken from the pool by a suspending fiber, whose wait data is keyed by us and has
+		// to reach the wait list before we run any job. Otherwise a job parking on us could wait for that fiber forever.
+		UpdateWaitData();
+	}
+
+	/// <summary>
+	/// Returns the fiber we just switched away from to the fiber pool. Has to be called after every switch
+	/// at which a fiber can be resumed.
+	/// </summary>
+	void JobScheduler::ReleasePendingFiber()
+	{
+		LPVOID fiber = TakeFiberToRelease();
+
+		if (fiber != nullptr)
+			ReturnFiber(fiber);
+	}
+
+	/// <summary>
+	/// Switches from the calling job to the given fiber until the job gets resumed. The jobs of the calling fiber's batch
+	/// that didn't run yet are handed back to their queue first and the parked time is excluded from the batch statistics.
+	/// </summary>
+	/// <param name="fiber">The fiber to continue on, whose wait data is already scheduled.</param>
+	void JobScheduler::ParkCurrentFiber(const LPVOID fiber)
+	{
+		// Fibers converted from a thread don't run batches
+		FiberData* const fiberData = GetCurrentFiberData();
+		if (fiberData != nullptr)
+			ReturnUnexecutedJobs(fiberData->m_Batch);
+
+		const std::chrono::steady_clock::time_point parkStart = std::chrono::steady_clock::now();
+
+		SwitchToFiber(fiber);
+		ReleasePendingFiber();
+
+		if (fiberData != nullptr)
+			fiberData->m_Batch.m_ParkedTime += std::chrono::steady_clock::now() - parkStart;
+	}
+
+	/// <summary>
+	/// Returns the next job in serial mode. Since there is only a single thread, all queues are drained by it
+	/// in the following order: main thread jobs, high, normal and low priority jobs.
+	/// </summary>
+	/// <returns>The next job or an invalid job if all queues are empty.</returns>
+	Job JobScheduler::GetNextSerialJob()
+	{
+		SchedulerData& data = *m_pData;
+		Jobs::Job jobCpy;
+
+		if (PopJobs(data.m_MainThreadJobQueue, &jobCpy, 1, 1) == 0)
+			GetNextPriorityJobs(&jobCpy, 1);
+
+		return jobCpy;
+	}
+
+	/// <summary>
+	/// Serial mode replacement for parking the fiber: Drains the deferred jobs inline on the calling thread
+	/// until the counter reached the desired count. Waiting jobs nest on the same stack, so a nested wait can only be
+	/// satisfied by jobs, IO or foreign threads but never by the frames below it, which only continue once it returned.
+	/// </summary>
+	/// <param name="cnt">The counter to wait on.</param>
+	/// <param name="desiredCount">The desired count the counter needs to reach in order to continue execution.</param>
+	void JobScheduler::RunSerialJobs(Counter* const cnt, const int desiredCount)
+	{
+		SchedulerData& data = *m_pData;
+		++data.m_SerialWaitDepth;
+
+		while (cnt->load(std::memory_order_acquire) > desiredCount)
+		{
+			Job jobCpy = GetNextSerialJob();
+
+			if (jobCpy.m_EntryPoint != nullptr)
+			{
+				ExecuteAndSampleJob(jobCpy);
+				continue;
+			}
+
+			// Nothing left to run -> The counter can only be signalled by IO or by a foreign thread.
+			PollIoCompletions();
+
+			// A nested wait without any pending IO most likely waits on a primitive held (or an event set) by an outer frame
+			assert((data.m_SerialWaitDepth == 1 || GetNumPendingIoRequests() > 0 || cnt->load(std::memory_order_acquire) <= desiredCount)
+				&& "Serial mode deadlock: A nested wait can't be satisfied by any queued job or pending IO. See job-sync.h for holding primitives across waits.");
+
+			std::this_thread::yield();
+		}
+
+		--data.m_SerialWaitDepth;
+	}
+
+	/// <summary>
+	/// The entry point of every pooled fiber. The fiber parameter is the fiber's data, which knows the scheduler owning the fiber.
+	/// </summary>
+	void WINAPI JobScheduler::FiberEntry(LPVOID fiberData)
+	{
+		static_cast<FiberData*>(fiberData)->m_pScheduler->RunFiber();
+	}
+
+	/// <summary>
+	/// The infinite fiber routine that is being run on each fiber. The individual routine steps are the following:
+	/// 1. Update the wait data and copy scheduled wait data to the wait list.
+	/// 2. Reap finished asynchronous IO requests, which makes their waiting fibers ready.
+	/// 3. Check the wait list for entries and exectue them prioritized.
+	/// 4. check if any job is available.
+	/// 5. If at least one job is available, get the next batch of jobs and execute them back to back.
+	/// A retired worker hands its current fiber back to the pool and returns to its thread routine.
+	/// </summary>
+	void JobScheduler::RunFiber()
+	{
+		SchedulerData& data = *m_pData;
+
+		// We might have been switched to from a fiber that is waiting to be returned to the pool
+		ReleasePendingFiber();
+
+		JobBatch& batch = GetCurrentFiberData()->m_Batch;
+
+		while (data.m_RunThreads)
+		{
+			if (data.m_WorkerSlots[GetThreadIndex()].m_State.load(std::memory_order_relaxed) == WORKER_RETIRING)
+			{
+				// Continues here once another worker picks this fiber from the pool
+				SetFiberToRelease(GetCurrentFiber());
+				SwitchToFiber(GetThreadFiber());
+				ReleasePendingFiber();
+				continue;
+			}
+
+			{
+				UpdateWaitData();	// @TODO: Try to somehow do this more elegantly!!
+
+				PollIoCompletions();
+
+				CheckWaitList();
+
+				if (data.m_JobQueueHigh.m_Jobs.empty() && data.m_JobQueueNormal.m_Jobs.empty() && data.m_JobQueueLow.m_Jobs.empty() && data.m_MainThreadJobQueue.m_Jobs.empty())
+					continue;
+
+				// Grab a batch of same priority jobs and run them back to back without re-entering the scheduler
+				batch.m_Count = GetNextJobs(batch.m_Jobs, GetJobBatchSize());
+
+				if (batch.m_Count == 0)
+				{
+					// The main thread only runs this routine while its own fiber waits -> Help draining the worker queues
+					if (GetThreadIndex() == MAIN_THREAD_INDEX)
+						RunStolenJobs();
+
+					continue;
+				}
+
+				batch.m_pQueue = GetThreadIndex() == MAIN_THREAD_INDEX ? &data.m_MainThreadJobQueue : &GetJobQueue(data, batch.m_Jobs[0].m_Priority);
+				batch.m_ParkedTime = std::chrono::nanoseconds::zero();
+
+				const std::chrono::steady_clock::time_point batchStart = std::chrono::steady_clock::now();
+
+				// A parking job hands the rest of the batch back, which ends the loop once this fiber resumes
+				for (batch.m_Next = 0; batch.m_Next < batch.m_Count;)
+				{
+					// Job will not have a fiber associated with it yet since this case is handled before!
+					Job& job = batch.m_Jobs[batch.m_Next++];
+					ExecuteAndSampleJob(job);
+					job = Job();
+				}
+
+				const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - batchStart - batch.m_ParkedTime;
+				UpdateJobBatchStatistics(batch.m_Count, elapsed);
+				batch.m_Count = 0;
+
+				// Only this thread writes its slot -> No read-modify-write needed. The jobs might have moved us to another thread!
+				WorkerSlot& slot = data.m_WorkerSlots[GetThreadIndex()];
+				slot.m_AverageJobNs.store(GetAverageJobNs(), std::memory_order_relaxed);
+				slot.m_BusyNs.store(slot.m_BusyNs.load(std::memory_order_relaxed) + elapsed.count(), std::memory_order_relaxed);
+			}
+		}
+
+		// Switch back to the initial RunThread Fiber
+		if (data.m_HasMainThread && std::this_thread::get_id() == data.m_MainThreadId)
+			return;
+
+		// Hand the fiber back to the pool, so it gets deleted with the pool instead of leaking
+		SetFiberToRelease(GetCurrentFiber());
+		SwitchToFiber(GetThreadFiber());
+	}
+
+	/// <summary>
+	/// Returns the fiber the calling worker thread was converted to.
+	/// </summary>
+	LPVOID JobScheduler::GetThreadFiber()
+	{
+		SchedulerData& data = *m_pData;
+
+		ScopedSpinLock lock(data.m_ThreadFibersLock);
+		return data.m_ThreadFibers.at(std::this_thread::get_id());
+	}
+
+	/// <summary>
+	/// Gets a fiber from the fiber pool.
+	/// </summary>
+	/// <returns>A new fiber to execute the nwext job on.</returns>
+	LPVOID JobScheduler::GetFiber()
+	{
+		SchedulerData& data = *m_pData;
+		LPVOID fiber;
+		// Critical section!
+		{
+			ScopedSpinLock lock(data.m_FiberPoolLock);
+			assert(data.m_FiberPool.size() != 0);
+
+			fiber = data.m_FiberPool.front();
+			data.m_FiberPool.pop();
+		}
+		return fiber;
+	}
+
+	/// <summary>
+	/// The thread routine. Since it switches to the fiber routine mid-function, it doesn't have to be a loop.
+	/// Also handles converting the fibers back to a thread.
+	/// </summary>
+	/// <param name="threadIndex">The index of the worker thread, which is also the index of its ready queue.</param>
+	void JobScheduler::RunThread(const int threadIndex)
+	{
+		SchedulerData& data = *m_pData;
+		SetThreadScheduler(this, threadIndex);
+
+		LPVOID threadFiber = ConvertThreadToFiber(0);
+		auto threadID = std::this_thread::get_id();
+
+		// Store the fibers running in this thread inside this list.
+		{
+			ScopedSpinLock lock(data.m_ThreadFibersLock);
+			data.m_ThreadFibers.emplace(threadID, threadFiber);
+		}
+
+		SwitchToFiber(GetFiber());
+
+		// The scheduler shut down or this worker got retired, in which case the fiber we came from goes back to the pool
+		ReleasePendingFiber();
+
+		{
+			ScopedSpinLock lock(data.m_ThreadFibersLock);
+			data.m_ThreadFibers.erase(threadID);
+		}
+
+		// Reconvert the fiber to a thread.
+		ConvertFiberToThread();
+		SetThreadScheduler(nullptr, -1);
+		printf("Terminating Thread %d ...\n", GetCurrentThreadId());
+
+		data.m_WorkerSlots[threadIndex].m_State.store(WORKER_FREE, std::memory_order_release);
+	}
+
+	/// <summary>
+	/// Spawns a worker in the first free slot and pins it to the scheduler's core mask.
+	/// Only called while initializing and by the scaling thread.
+	/// </summary>
+	/// <returns>True if a worker was spawned, false if every slot is taken or a retired worker is still shutting down.</returns>
+	bool JobScheduler::GrowWorkers()
+	{
+		SchedulerData& data = *m_pData;
+
+		for (int index = MAIN_THREAD_INDEX + 1; index < (int)data.m_WorkerSlots.size(); ++index)
+		{
+			WorkerSlot& slot = data.m_WorkerSlots[index];
+
+			if (slot.m_State.load(std::memory_order_acquire) != WORKER_FREE)
+				continue;
+
+			// A previously retired worker already left its routine -> Joining doesn't block
+			if (slot.m_pThread != nullptr)
+			{
+				slot.m_pThread->join();
+				delete slot.m_pThread;
+			}
+
+			slot.m_State.store(WORKER_ACTIVE, std::memory_order_relaxed);
+			slot.m_pThread = new std::thread(&JobScheduler::RunThread, this, index);
+
+			if (data.m_AffinityMask != 0)
+			{
+				const DWORD_PTR previousMask = SetThreadAffinityMask((HANDLE)slot.m_pThread->native_handle(), (DWORD_PTR)data.m_AffinityMask);
+				if (previousMask == 0)
+					printf("Failed to set the affinity mask of worker thread %d\n", index);
+			}
+
+			data.m_NumWorkers.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		return false;
+	}
+
+	/// <summary>
+	/// Asks the active worker with the highest index to retire. The worker finishes its current batch, hands
+	/// its fiber back to the pool and terminates. Fibers that prefer its ready queue get stolen by the others.
+	/// </summary>
+	/// <returns>True if a worker was asked to retire.</returns>
+	bool JobScheduler::RetireWorker()
+	{
+		SchedulerData& data = *m_pData;
+
+		for (int index = (int)data.m_WorkerSlots.size() - 1; index > MAIN_THREAD_INDEX; --index)
+		{
+			WorkerSlot& slot = data.m_WorkerSlots[index];
+
+			if (slot.m_State.load(std::memory_order_relaxed) != WORKER_ACTIVE)
+				continue;
+
+			slot.m_State.store(WORKER_RETIRING, std::memory_order_relaxed);
+			data.m_NumWorkers.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		return false;
+	}
+
+	/// <summary>
+	/// Returns the amount of jobs waiting in the priority queues.
+	/// </summary>
+	int JobScheduler::GetQueuedJobCount()
+	{
+		SchedulerData& data = *m_pData;
+		int count = 0;
+
+		{
+			ScopedSpinLock lock(data.m_JobQueueHigh.m_Lock);
+			count += (int)data.m_JobQueueHigh.m_Jobs.size();
+		}
+		{
+			ScopedSpinLock lock(data.m_JobQueueNormal.m_Lock);
+			count += (int)data.m_JobQueueNormal.m_Jobs.size();
+		}
+		{
+			ScopedSpinLock lock(data.m_JobQueueLow.m_Lock);
+			count += (int)data.m_JobQueueLow.m_Jobs.size();
+		}
+
+		return count;
+	}
+
+	/// <summary>
+	/// The routine of the scaling thread of an elastic scheduler. Samples the queue pressure and the utilization of the
+	/// workers in a fixed interval and passes the samples to UpdateScaling.
+	/// </summary>
+	void JobScheduler::RunScalingThread()
+	{
+		SchedulerData& data = *m_pData;
+
+		std::vector<long long> lastBusyNs(data.m_WorkerSlots.size(), 0);
+		std::chrono::steady_clock::time_point lastSample = std::chrono::steady_clock::now();
+
+		while (data.m_RunThreads.load(std::memory_order_acquire))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(WORKER_SCALING_INTERVAL_MS()));
+
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			const double intervalNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastSample).count();
+			lastSample = now;
+
+			const int numWorkers = data.m_NumWorkers.load(std::memory_order_relaxed);
+
+			ScalingSample sample{};
+			sample.m_QueuedJobs = GetQueuedJobCount();
+
+			double busyNs = 0.0;
+
+			for (int index = MAIN_THREAD_INDEX + 1; index < (int)data.m_WorkerSlots.size(); ++index)
+			{
+				WorkerSlot& slot = data.m_WorkerSlots[index];
+				const long long slotBusyNs = slot.m_BusyNs.load(std::memory_order_relaxed);
+
+				busyNs += (double)(slotBusyNs - lastBusyNs[index]);
+				lastBusyNs[index] = slotBusyNs;
+
+				if (slot.m_State.load(std::memory_order_relaxed) == WORKER_ACTIVE)
+					sample.m_AverageJobNs += slot.m_AverageJobNs.load(std::memory_order_relaxed);
+			}
+
+			sample.m_AverageJobNs /= std::max(numWorkers, 1);
+			sample.m_Utilization = busyNs / (intervalNs * std::max(numWorkers, 1));
+
+			UpdateScaling(sample);
+		}
+	}
+
+	/// <summary>
+	/// Feeds a load sample into the scaling decisions of an elastic scheduler:
+	/// - Grows the pool if the estimated queueing delay stays above WORKER_GROW_WAIT_US for WORKER_GROW_SAMPLES samples.
+	/// - Retires a worker if the queues stay empty and the workers mostly idle for WORKER_RETIRE_SAMPLES samples.
+	/// Both windows restart after every decision, so the pool changes by at most one worker per window. Called by the
+	/// scaling thread, hence only to be called by the owner of schedulers without automatic scaling and never concurrently.
+	/// </summary>
+	/// <param name="sample">The load observed since the previous sample.</param>
+	/// <returns>True if a worker was added or retired.</returns>
+	bool JobScheduler::UpdateScaling(const ScalingSample& sample)
+	{
+		SchedulerData& data = *m_pData;
+
+		const int numWorkers = data.m_NumWorkers.load(std::memory_order_relaxed);
+
+		// Little's law: The backlog drains at one job per average job duration and worker
+		const double estimatedWaitUs = sample.m_QueuedJobs * sample.m_AverageJobNs / std::max(numWorkers, 1) / 1000.0;
+
+		const bool underPressure = sample.m_QueuedJobs > numWorkers && estimatedWaitUs > WORKER_GROW_WAIT_US();
+		const bool idle = sample.m_QueuedJobs == 0 && sample.m_Utilization < WORKER_RETIRE_UTILIZATION();
+
+		data.m_PressureSamples = underPressure ? data.m_PressureSamples + 1 : 0;
+		data.m_IdleSamples = idle ? data.m_IdleSamples + 1 : 0;
+
+		ScalingEvent scalingEvent{};
+
+		if (data.m_PressureSamples >= WORKER_GROW_SAMPLES() && numWorkers < data.m_MaxWorkers && GrowWorkers())
+		{
+			scalingEvent.m_Action = ScalingAction::GROW;
+		}
+		else if (data.m_IdleSamples >= WORKER_RETIRE_SAMPLES() && numWorkers > data.m_MinWorkers && RetireWorker())
+		{
+			scalingEvent.m_Action = ScalingAction::RETIRE;
+		}
+		else
+		{
+			return false;
+		}
+
+		data.m_PressureSamples = 0;
+		data.m_IdleSamples = 0;
+
+		if (data.m_ScalingCallback)
+		{
+			scalingEvent.m_NumWorkers = data.m_NumWorkers.load(std::memory_order_relaxed);
+			scalingEvent.m_QueuedJobs = sample.m_QueuedJobs;
+			scalingEvent.m_EstimatedWaitUs = estimatedWaitUs;
+			scalingEvent.m_Time = std::chrono::steady_clock::now();
+
+			data.m_ScalingCallback(scalingEvent);
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// Creates and initializes the fiber pool of this scheduler.
+	/// </summary>
+	void JobScheduler::CreateFiberPool()
+	{
+		SchedulerData& data = *m_pData;
+
+		data.m_FiberData.reserve(NUM_FIBERS());
+
+		for (int i = 0; i < NUM_FIBERS(); ++i)
+		{
+			data.m_FiberData.push_back(std::make_unique<FiberData>());
+			data.m_FiberData.back()->m_pScheduler = this;
+
+			LPVOID fiber = CreateFiber(1024, (LPFIBER_START_ROUTINE)&JobScheduler::FiberEntry, data.m_FiberData.back().get());
+			data.m_FiberPool.push(fiber);
+		}
+
+		data.m_WaitList.reserve(data.m_FiberPool.size());
+	}
+
+	/// <summary>
+	/// Creates and initializes the thread pool and some dependant resources.
+	/// </summary>
+	/// <param name="numOfThreads">The amount of threads to spawn in the thread pool.</param>
+	void JobScheduler::CreateThreadPool(const int numOfThreads)
+	{
+		SchedulerData& data = *m_pData;
+
+		// Init map and slots with the maximum amount of worker threads to be spawned
+		data.m_ThreadFibers.reserve(data.m_MaxWorkers);
+		data.m_WorkerSlots = std::vector<WorkerSlot>(data.m_MaxWorkers + 1);
+
+		// One ready queue for the main thread and one for each worker slot
+		data.m_ReadyQueues = std::vector<ReadyQueue>(data.m_MaxWorkers + 1);
+
+		for (int t_index = 0; t_index < numOfThreads; ++t_index)
+		{
+			GrowWorkers();
+		}
+	}
+
+	/// <summary>
+	/// Returns a fiber to the fiber pool.
+	/// </summary>
+	/// <param name="fiber"></param>
+	void JobScheduler::ReturnFiber(const LPVOID fiber)
+	{
+		SchedulerData& data = *m_pData;
+
+		// Critical section!
+		{
+			ScopedSpinLock lock(data.m_FiberPoolLock);
+			data.m_FiberPool.push(fiber);
+		}
+	}
+
+	/// <summary>
+	/// Schedules a job to be executed by the worker threads. Critical jobs share the high priority queue and jobs signalling
+	/// a counter a more important job waits on are recorded as pending signallers of the counter.
+	/// </summary>
+	/// <param name="job">The job to be executed.</param>
+	void JobScheduler::KickJob(const Job& job)
+	{
+		SchedulerData& data = *m_pData;
+
+		if (RecordPendingSignaller(job))
+			return;
+
+		JobQueue& queue = GetJobQueue(data, job.m_Priority);
+
+		ScopedSpinLock lock(queue.m_Lock);
+		queue.m_Jobs.push_back(job);
+	}
+
+	/// <summary>
+	/// Schedules a bunch of jobs to be executed by the worker threads.
+	/// </summary>
+	/// <param name="jobs">A pointer to the job array.</param>
+	/// <param name="jobCount">The amount of jobs to be scheduled. Must be the size of the referenced job array.</param>
+	void JobScheduler::KickJobs(Job* const jobs, const int jobCount)
+	{
+		SchedulerData& data = *m_pData;
+
+		for (int i = 0; i < jobCount; ++i)
+		{
+			if (RecordPendingSignaller(jobs[i]))
+				continue;
+
+			JobQueue& queue = GetJobQueue(data, jobs[i].m_Priority);
+
+			ScopedSpinLock lock(queue.m_Lock);
+			queue.m_Jobs.push_back(jobs[i]);
+		}
+	}
+
+	/// <summary>
+	/// Executes the job inline on the calling fiber if its learned cost is below JOB_INLINE_THRESHOLD_NS, which saves the
+	/// queueing round trip for tiny jobs. Unknown and expensive job types are kicked, as are jobs kicked from threads
+	/// not owned by this scheduler.
+	/// </summary>
+	/// <param name="job">The job to be executed.</param>
+	/// <returns>True if the job was executed inline.</returns>
+	bool JobScheduler::KickOrInline(const Job& job)
+	{
+		double estimateNs = 0.0;
+
+		if (GetThreadScheduler() != this || !GetJobCostEstimate(job.m_FunctionName, estimateNs) || estimateNs >= JOB_INLINE_THRESHOLD_NS())
+		{
+			KickJob(job);
+			return false;
+		}
+
+		// Keep sampling inlined jobs, so a job type growing more expensive is noticed
+		Job jobCpy = job;
+		ExecuteAndSampleJob(jobCpy);
+		return true;
+	}
+
+	/// <summary>
+	/// Kicks all expensive and unknown jobs at once and executes the tiny ones inline afterwards, so the workers
+	/// already start on the expensive ones while the calling fiber runs the tiny ones.
+	/// </summary>
+	/// <param name="jobs">A pointer to the job array. The order of the jobs is changed!</param>
+	/// <param name="jobCount">The amount of jobs. Must be the size of the referenced job array.</param>
+	/// <returns>The amount of jobs executed inline.</returns>
+	int JobScheduler::KickOrInlineJobs(Job* const jobs, const int jobCount)
+	{
+		if (GetThreadScheduler() != this)
+		{
+			KickJobs(jobs, jobCount);
+			return 0;
+		}
+
+		// Move the jobs to kick to the front
+		Job* const firstInline = std::stable_partition(jobs, jobs + jobCount, [](const Job& job)
+			{
+				double estimateNs = 0.0;
+				return !GetJobCostEstimate(job.m_FunctionName, estimateNs) || estimateNs >= JOB_INLINE_THRESHOLD_NS();
+			});
+
+		const int kickCount = (int)(firstInline - jobs);
+		KickJobs(jobs, kickCount);
+
+		for (int i = kickCount; i < jobCount; ++i)
+		{
+			ExecuteAndSampleJob(jobs[i]);
+		}
+
+		return jobCount - kickCount;
+	}
+
+	/// <summary>
+	/// Schedules a job to be executed by the main thread.
+	/// Do not use this extensively or the performance will be similar to single core performance plus overhead!!
+	/// </summary>
+	/// <param name="job">The job to be executed on the main thread.</param>
+	void JobScheduler::KickMainThreadJob(const Job& job)
+	{
+		SchedulerData& data = *m_pData;
+		assert(data.m_HasMainThread && "The scheduler has no main thread!");
+
+		ScopedSpinLock lock(data.m_MainThreadJobQueue.m_Lock);
+		data.m_MainThreadJobQueue.m_Jobs.push_back(job);
+	}
+
+	/// <summary>
+	/// Schedules multiple jobs to be executed by the main thread.
+	/// Do not use this extensively or the performance will be similar to single core performance plus overhead!!
+	/// </summary>
+	/// <param name="jobs">The jobs to be executed on the main thread.</param>
+	/// <param name="jobCount">The amount of jobs to be executed on the main thread.</param>
+	void JobScheduler::KickMainThreadJobs(Job* const jobs, const int jobCount)
+	{
+		SchedulerData& data = *m_pData;
+		assert(data.m_HasMainThread && "The scheduler has no main thread!");
+
+		ScopedSpinLock lock(data.m_MainThreadJobQueue.m_Lock);
+
+		for (int i = 0; i < jobCount; ++i)
+		{
+			data.m_MainThreadJobQueue.m_Jobs.push_back(std::move(jobs[i]));
+		}
+	}
+
+	/// <summary>
+	/// Checks if a job + fiber was recently pushed to be scheduled in the wait list.
+	/// If the fiber that scheduled the waitdata was already switched from, the wait data can be safely pushed to the wait list.
+	/// !! ***Important: This function seems to be unnecessary overhead but is essential for avoiding race conditions of the fiber
+	/// being not switched from yet but already finished in the wait list.*** !!
+	/// </summary>
+	void JobScheduler::UpdateWaitData()
+	{
+		SchedulerData& data = *m_pData;
+
+		ScopedSpinLock lock(data.m_ScheduleListLock);
+		if (data.m_ScheduleList.empty())
+		{
+			return;
+		}
+
+		LPVOID currentFiber = GetCurrentFiber();
+
+		if (data.m_ScheduleList.contains(currentFiber))
+		{
+			WaitData waitDataCpy = std::move(data.m_ScheduleList[currentFiber]);
+			data.m_ScheduleList.erase(currentFiber);
+
+			{
+				ScopedSpinLock wl_lock(data.m_WaitListLock);
+				data.m_WaitList.push_back(std::move(waitDataCpy));
+				data.m_NumWaitingFibers.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Queues proxies that each run one of the pending signallers of the counter.
+	/// </summary>
+	/// <param name="cnt">The counter the pending signallers signal.</param>
+	/// <param name="priority">The priority to queue the proxies with.</param>
+	/// <param name="count">The amount of proxies to queue.</param>
+	void JobScheduler::QueueSignallerProxies(Counter* const cnt, const Priority priority, const int count)
+	{
+		JobQueue& queue = GetJobQueue(*m_pData, priority);
+
+		ScopedSpinLock lock(queue.m_Lock);
+
+		for (int i = 0; i < count; ++i)
+		{
+			queue.m_Jobs.emplace_back([this, cnt](uintptr_t) { RunPendingSignaller(cnt); }, priority, std::string());
+		}
+	}
+
+	/// <summary>
+	/// Records a job signalling a counter that a more important job waits on as pending signaller and queues a proxy for it,
+	/// so it inherits the priority of the waiters right away. Kicks only touch the lock while somebody waits with a boost.
+	/// </summary>
+	/// <param name="job">The job about to be kicked.</param>
+	/// <returns>True if the job was recorded and must not be queued by the caller.</returns>
+	bool JobScheduler::RecordPendingSignaller(const Job& job)
+	{
+		SchedulerData& data = *m_pData;
+
+		// Nothing to inherit beyond the high priority queue
+		if (!data.m_PriorityInheritance || job.m_Priority >= Priority::HIGH)
+			return false;
+
+		// Nobody lends a priority -> Don't touch the lock
+		if (data.m_NumBoostedWaits.load(std::memory_order_relaxed) == 0)
+			return false;
+
+		Counter* const cnt = GetSignalledCounter(job);
+		if (cnt == nullptr)
+			return false;
+
+		Priority priority = job.m_Priority;
+
+		{
+			ScopedSpinLock lock(data.m_PendingSignallersLock);
+
+			auto it = data.m_PendingSignallers.find(cnt);
+			if (it == data.m_PendingSignallers.end() || it->second.m_NumWaiters == 0 || it->second.m_Priority <= job.m_Priority)
+				return false;
+
+			PendingSignallers& signallers = it->second;
+			signallers.m_Jobs.push_back(job);
+			++signallers.m_NumProxies;
+
+			priority = signallers.m_Priority;
+		}
+
+		QueueSignallerProxies(cnt, priority, 1);
+		return true;
+	}
+
+	/// <summary>
+	/// The routine of a proxy: Runs the oldest pending signaller of the counter with the priority inherited from its waiters.
+	/// Nothing is left if another proxy was faster, since a boost queues an additional proxy for every pending signaller.
+	/// </summary>
+	/// <param name="cnt">The counter the pending signallers signal.</param>
+	void JobScheduler::RunPendingSignaller(Counter* const cnt)
+	{
+		SchedulerData& data = *m_pData;
+		Job job;
+
+		{
+			ScopedSpinLock lock(data.m_PendingSignallersLock);
+
+			auto it = data.m_PendingSignallers.find(cnt);
+			assert(it != data.m_PendingSignallers.end());
+
+			PendingSignallers& signallers = it->second;
+			--signallers.m_NumProxies;
+
+			if (!signallers.m_Jobs.empty())
+			{
+				job = std::move(signallers.m_Jobs.front());
+				signallers.m_Jobs.pop_front();
+
+				// Boosted jobs keep the inherited priority, so it is passed on to the jobs they wait on in turn
+				job.m_Priority = std::max(job.m_Priority, signallers.m_Priority);
+			}
+
+			if (signallers.m_NumProxies == 0 && signallers.m_NumWaiters == 0)
+			{
+				assert(signallers.m_Jobs.empty());
+
+				data.m_PendingSignallers.erase(it);
+			}
+		}
+
+		if (job.m_EntryPoint != nullptr)
+			ExecuteAndSampleJob(job);
+	}
+
+	/// <summary>
+	/// Lets the signallers of the counter inherit the priority of a job about to wait on it. Signallers that are already queued
+	/// with a lower priority are searched near the back of their queues, where children kicked right before the wait end up,
+	/// and get a proxy in the waiter's queue. Signallers kicked while the job waits are recorded with its priority directly.
+	/// This is best effort: Signallers deeper in a backlog than PRIORITY_INHERITANCE_SCAN_DEPTH keep their priority.
+	/// </summary>
+	/// <param name="cnt">The counter about to be waited on.</param>
+	/// <param name="priority">The priority of the waiting job.</param>
+	/// <param name="desiredCount">The count the waiter waits for, which bounds the amount of signallers left.</param>
+	void JobScheduler::BoostCounter(Counter* const cnt, const Priority priority, const int desiredCount)
+	{
+		SchedulerData& data = *m_pData;
+		int numProxies = 0;
+
+		{
+			ScopedSpinLock lock(data.m_PendingSignallersLock);
+
+			PendingSignallers& signallers = data.m_PendingSignallers[cnt];
+
+			// Waiters of a lower or the same priority find the signallers already recorded and their proxies queued
+			if (priority > signallers.m_Priority)
+			{
+				numProxies = (int)signallers.m_Jobs.size();
+				signallers.m_Priority = priority;
+
+				const int maxCount = cnt->load(std::memory_order_relaxed) - desiredCount;
+				int found = TakeQueuedSignallers(data.m_JobQueueLow, cnt, signallers.m_Jobs, maxCount);
+				if (priority > Priority::NORMAL)
+					found += TakeQueuedSignallers(data.m_JobQueueNormal, cnt, signallers.m_Jobs, maxCount - found);
+
+				numProxies += found;
+			}
+
+			signallers.m_NumProxies += numProxies;
+			++signallers.m_NumWaiters;
+			data.m_NumBoostedWaits.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (numProxies > 0)
+			QueueSignallerProxies(cnt, priority, numProxies);
+	}
+
+	/// <summary>
+	/// Drops the priority a resumed waiter lent to the counter. The counter keeps the highest priority of its waiters
+	/// until the last one of them resumed.
+	/// </summary>
+	/// <param name="cnt">The counter the waiter waited on.</param>
+	void JobScheduler::UnboostCounter(Counter* const cnt)
+	{
+		SchedulerData& data = *m_pData;
+		ScopedSpinLock lock(data.m_PendingSignallersLock);
+
+		auto it = data.m_PendingSignallers.find(cnt);
+		assert(it != data.m_PendingSignallers.end());
+
+		PendingSignallers& signallers = it->second;
+		data.m_NumBoostedWaits.fetch_sub(1, std::memory_order_relaxed);
+
+		if (--signallers.m_NumWaiters > 0)
+			return;
+
+		signallers.m_Priority = Priority::LOW;
+
+		if (signallers.m_NumProxies == 0)
+		{
+			assert(signallers.m_Jobs.empty());
+
+			data.m_PendingSignallers.erase(it);
+		}
+	}
+
+	/// <summary>
+	/// Waits for the counter to become the desired count (or by default 0) and puts the job onto the wait list during meantime.
+	/// This call is the synchronisation point in the execution flow. Has to be called from a thread owned by this scheduler.
+	/// While it waits, the calling job lends its priority to the pending jobs signalling the counter.
+	/// </summary>
+	/// <param name="cnt">The counter to wait on.</param>
+	/// <param name="desiredCount">The desired count the counter needs to reach in order to continue execution.</param>
+	void JobScheduler::WaitForCounter(Counter* const cnt, const int desiredCount)
+	{
+		SchedulerData& data = *m_pData;
+		assert(GetThreadScheduler() == this && "Only threads of the scheduler can park on it!");
+
+		if (cnt->load(std::memory_order_consume) <= desiredCount)
+			return;
+
+		const Priority priority = GetJobPriority();
+		const bool boost = data.m_PriorityInheritance && priority > Priority::LOW;
+
+		if (boost)
+			BoostCounter(cnt, priority, desiredCount);
+
+		ParkUntilSignalled(cnt, desiredCount);
+
+		if (boost)
+			UnboostCounter(cnt);
+	}
+
+	/// <summary>
+	/// Waits like WaitForCounter, but doesn't lend the calling job's priority to anybody. Meant for counters that are
+	/// signalled by other fibers or by IO instead of jobs, like the wait nodes of the synchronisation primitives.
+	/// </summary>
+	/// <param name="cnt">The counter to wait on.</param>
+	/// <param name="desiredCount">The desired count the counter needs to reach in order to continue execution.</param>
+	void JobScheduler::WaitForSignal(Counter* const cnt, const int desiredCount)
+	{
+		assert(GetThreadScheduler() == this && "Only threads of the scheduler can park on it!");
+
+		if (cnt->load(std::memory_order_consume) <= desiredCount)
+			return;
+
+		ParkUntilSignalled(cnt, desiredCount);
+	}
+
+	/// <summary>
+	/// Parks the calling fiber on the wait list until the counter reached the desired count. Runs the queued jobs inline
+	/// instead in serial mode.
+	/// </summary>
+	/// <param name="cnt">The counter to wait on.</param>
+	/// <param name="desiredCount">The desired count the counter needs to reach in order to continue execution.</param>
+	void JobScheduler::ParkUntilSignalled(Counter* const cnt, const int desiredCount)
+	{
+		SchedulerData& data = *m_pData;
+
+		if (data.m_SerialMode)
+		{
+			RunSerialJobs(cnt, desiredCount);
+			return;
+		}
+
+		// Lives on the fiber's stack, since the fiber might be resumed on another thread
+		const Priority priority = GetJobPriority();
+
+		// Fetch new fiber
+		LPVOID fiber = GetFiber();
+		assert(fiber != nullptr);
+
+		// Stolen jobs resume on the worker chosen when stealing them
+		const FiberData* const fiberData = GetCurrentFiberData();
+		const int threadIndex = fiberData != nullptr && fiberData->m_ResumeThreadIndex != -1 ? fiberData->m_ResumeThreadIndex : GetThreadIndex();
+
+		// Schedule for wait list!
+		{
+			ScopedSpinLock lock(data.m_ScheduleListLock);
+			data.m_ScheduleList.emplace(fiber, std::move(WaitData(GetCurrentFiber(), cnt, desiredCount, threadIndex)));
+		}
+
+		ParkCurrentFiber(fiber);
+
+		// The thread we resumed on ran other jobs in meantime
+		SetJobPriority(priority);
+	}
+
+	/// <summary>
+	/// Waits for the counter to become the desired count (or by default 0) and puts the job onto the wait list during meantime.
+	/// When done, this function frees the heap allocated counter. This call is the synchronisation point in the execution flow.
+	/// </summary>
+	/// <param name="cnt">The counter to wait on. Expected to be heap allocated!</param>
+	/// <param name="desiredCount">The desired count the counter needs to reach in order to continue execution.</param>
+	void JobScheduler::WaitForCounterAndFree(Counter* const cnt, const int desiredCount)
+	{
+		WaitForCounter(cnt, desiredCount);
+		delete cnt;
+	}
+
+	/// <summary>
+	/// Waits until every child of the sharded counter finished. The wait list only polls the root of the counter,
+	/// which the children touch once per exhausted shard.
+	/// </summary>
+	/// <param name="cnt">The sharded counter to wait on.</param>
+	void JobScheduler::WaitForCounter(ShardedCounter& cnt)
+	{
+		WaitForCounter(cnt.GetRoot(), 0);
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+#include <chrono>
+#include <functional>
+
+namespace Borealis::Jobs
+{
+	enum class ScalingAction : short
+	{
+		GROW = 0,
+		RETIRE = 1,
+	};
+
+	/// <summary>
+	/// Describes a single scaling decision of an elastic scheduler.
+	/// </summary>
+	struct ScalingEvent
+	{
+		ScalingAction m_Action = ScalingAction::GROW;
+		int m_NumWorkers = 0;							// The amount of workers after the decision
+		int m_QueuedJobs = 0;							// The amount of queued jobs when the decision was made
+		double m_EstimatedWaitUs = 0.0;					// The estimated queueing delay when the decision was made
+		std::chrono::steady_clock::time_point m_Time{};
+	};
+
+	typedef std::function<void(const ScalingEvent& scalingEvent)> ScalingCallback;
+
+	/// <summary>
+	/// The load of an elastic scheduler observed over one scaling interval, which the scaling decisions are based on.
+	/// </summary>
+	struct ScalingSample
+	{
+		int m_QueuedJobs = 0;							// The amount of jobs waiting in the priority queues
+		double m_AverageJobNs = 0.0;					// The average job duration of the active workers
+		double m_Utilization = 0.0;						// Share of the interval the workers spent executing jobs
+	};
+
+	/// <summary>
+	/// Describes how a scheduler instance is set up.
+	/// </summary>
+	struct JobSchedulerDesc
+	{
+		// The amount of worker threads. -1 uses one worker per logical core besides the main thread.
+		// 0 selects the serial mode, which is only available if the calling thread is adopted.
+		int m_NumOfThreads = -1;
+
+		// The upper bound for elastic scaling. Values above m_NumOfThreads let the pool grow while the queues are under
+		// pressure and retire workers again after sustained idleness, but never below m_NumOfThreads. 0 keeps the pool fixed.
+		int m_MaxNumOfThreads = 0;
+
+		// Invoked from the scaling thread (or UpdateScaling) for every scaling decision.
+		ScalingCallback m_ScalingCallback{};
+
+		// Whether a scaling thread samples the load every WORKER_SCALING_INTERVAL_MS. Without it the pool only scales
+		// when the owner passes its own samples to UpdateScaling, e.g. once per frame or deterministically in tests.
+		bool m_AutomaticScaling = true;
+
+		// The logical cores the workers may run on. 0 leaves the workers unpinned.
+		unsigned long long m_AffinityMask = 0;
+
+		// Whether the initializing thread becomes the scheduler's main thread and is converted to a fiber.
+		// A thread can only be the main thread of a single scheduler.
+		bool m_AdoptCallingThread = true;
+
+		// Whether a waiting job lends its priority to the pending jobs signalling the counter it waits on, so children
+		// kicked with a lower priority don't queue up behind unrelated jobs while a more important parent waits for them.
+		bool m_PriorityInheritance = true;
+	};
+
+	struct SchedulerData;
+
+	/// <summary>
+	/// An isolated job scheduler owning its worker threads, fibers, job queues and wait lists.
+	/// Multiple schedulers can run side by side with their own thread counts and core masks, so the backlog of one
+	/// pool never inflates the latency of another. The free functions of the job system operate on the scheduler
+	/// owning the calling thread, which is the default scheduler for any thread not belonging to a scheduler.
+	/// </summary>
+	class BOREALIS_API JobScheduler
+	{
+	public:
+		JobScheduler();
+		~JobScheduler();
+
+		JobScheduler(const JobScheduler&) = delete;
+		JobScheduler& operator=(const JobScheduler&) = delete;
+
+		void Initialize(const JobSchedulerDesc& desc = JobSchedulerDesc());
+		void Deinitialize();
+		bool IsInitialized() const;
+		int GetNumWorkers() const;
+		int GetNumPooledFibers() const;
+
+		void KickJob(const Job& job);
+		void KickJobs(Job* const jobs, const int jobCount);
+
+		bool KickOrInline(const Job& job);
+		int	 KickOrInlineJobs(Job* const jobs, const int jobCount);
+
+		void KickMainThreadJob(const Job& job);
+		void KickMainThreadJobs(Job* const jobs, const int jobCount);
+
+		void WaitForCounter(Counter* const cnt, const int desiredCount = 0);
+		void WaitForCounterAndFree(Counter* const cnt, const int desiredCount = 0);
+		void WaitForCounter(ShardedCounter& cnt);
+		void WaitForSignal(Counter* const cnt, const int desiredCount = 0);
+
+		void ForceMainThreadExecution();
+		bool UpdateScaling(const ScalingSample& sample);
+		void SetMaxJobBatchSize(const int maxBatchSize);
+		void SetMainThreadStealBudget(const std::chrono::microseconds budget);
+
+		static JobScheduler& Default();
+		static JobScheduler& Current();
+
+	private:
+		Job	 GetNextJob();
+		int	 GetNextJobs(Job* const jobs, const int maxCount);
+		Job	 GetNextPriorityJob();
+		int	 GetNextPriorityJobs(Job* const jobs, const int maxCount);
+		Job	 GetNextSerialJob();
+		int	 GetJobBatchSize() const;
+		int	 StealWorkerJobs(Job* const jobs, const int maxCount, const double budgetNs);
+		void RunStolenJobs();
+		void RunSerialJobs(Counter* const cnt, const int desiredCount);
+		void CheckWaitList();
+		void PromoteReadyFibers();
+		LPVOID PopReadyFiber(const int threadIndex);
+		void ReleasePendingFiber();
+		void ParkCurrentFiber(const LPVOID fiber);
+		void RunFiber();
+		LPVOID GetFiber();
+		void RunThread(const int threadIndex);
+		void RunScalingThread();
+		int	 GetQueuedJobCount();
+		bool GrowWorkers();
+		bool RetireWorker();
+		LPVOID GetThreadFiber();
+		void CreateFiberPool();
+		void CreateThreadPool(const int numOfThreads);
+		void ReturnFiber(const LPVOID fiber);
+		void UpdateWaitData();
+		void ParkUntilSignalled(Counter* const cnt, const int desiredCount);
+		void QueueSignallerProxies(Counter* const cnt, const Priority priority, const int count);
+		bool RecordPendingSignaller(const Job& job);
+		void RunPendingSignaller(Counter* const cnt);
+		void BoostCounter(Counter* const cnt, const Priority priority, const int desiredCount);
+		void UnboostCounter(Counter* const cnt);
+
+		static void WINAPI FiberEntry(LPVOID fiberData);
+
+		SchedulerData* m_pData = nullptr;
+	};
+}
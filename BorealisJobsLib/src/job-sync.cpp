@@ -0,0 +1,231 @@
+#include "job-sync.h"
+#include "job-system.h"
+#include "scoped-spinlock.h"
+
+namespace Borealis::Jobs
+{
+	/// <summary>
+	/// Makes a parked waiter runnable again. The node must not be touched afterwards since
+	/// it lives on the stack of the resumed fiber!
+	/// </summary>
+	/// <param name="node">The waiter to resume.</param>
+	static void ResumeWaiter(JobWaitNode* const node)
+	{
+		node->m_Counter.store(0, std::memory_order_release);
+	}
+
+	/// <summary>
+	/// Resumes a detached list of waiters in FIFO order.
+	/// </summary>
+	/// <param name="head">The first waiter of the list.</param>
+	static void ResumeWaiters(JobWaitNode* head)
+	{
+		while (head != nullptr)
+		{
+			JobWaitNode* next = head->m_pNext;
+			ResumeWaiter(head);
+			head = next;
+		}
+	}
+
+	// ------------------ JobMutex ------------------
+
+	/// <summary>
+	/// Locks the mutex. Spins shortly and parks the calling fiber afterwards.
+	/// When resumed, the fiber already owns the mutex.
+	/// </summary>
+	void JobMutex::Lock()
+	{
+		for (int i = 0; i < SYNC_SPIN_COUNT(); ++i)
+		{
+			if (!m_Locked.load(std::memory_order_relaxed) && TryLock())
+				return;
+
+			YieldProcessor();
+		}
+
+		JobWaitNode node;
+
+		{
+			ScopedSpinLock lock(m_Guard);
+
+			if (TryLock())
+				return;
+
+			m_Waiters.Push(&node);
+		}
+
+		WaitForSignal(&node.m_Counter);
+	}
+
+	/// <summary>
+	/// Tries to lock the mutex without waiting. Never overtakes parked waiters since the mutex
+	/// stays locked while the ownership is handed over to them.
+	/// </summary>
+	/// <returns>True if the mutex is now owned by the caller.</returns>
+	bool JobMutex::TryLock()
+	{
+		bool expected = false;
+		return m_Locked.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Unlocks the mutex. If fibers are waiting, the ownership is handed directly to the oldest waiter.
+	/// </summary>
+	void JobMutex::Unlock()
+	{
+		JobWaitNode* next = nullptr;
+
+		{
+			ScopedSpinLock lock(m_Guard);
+			next = m_Waiters.Pop();
+
+			if (next == nullptr)
+				m_Locked.store(false, std::memory_order_release);
+		}
+
+		if (next != nullptr)
+			ResumeWaiter(next);
+	}
+
+	// ------------------ JobSemaphore ------------------
+
+	JobSemaphore::JobSemaphore(const int initialCount)
+		: m_Count(initialCount)
+	{ }
+
+	/// <summary>
+	/// Acquires a permit. Spins shortly and parks the calling fiber afterwards.
+	/// When resumed, the permit was already handed over to the fiber.
+	/// </summary>
+	void JobSemaphore::Acquire()
+	{
+		for (int i = 0; i < SYNC_SPIN_COUNT(); ++i)
+		{
+			if (m_Count.load(std::memory_order_relaxed) > 0 && TryAcquire())
+				return;
+
+			YieldProcessor();
+		}
+
+		JobWaitNode node;
+
+		{
+			ScopedSpinLock lock(m_Guard);
+
+			if (TryAcquire())
+				return;
+
+			m_Waiters.Push(&node);
+		}
+
+		WaitForSignal(&node.m_Counter);
+	}
+
+	/// <summary>
+	/// Tries to acquire a permit without waiting.
+	/// </summary>
+	/// <returns>True if a permit was acquired.</returns>
+	bool JobSemaphore::TryAcquire()
+	{
+		int count = m_Count.load(std::memory_order_relaxed);
+
+		while (count > 0)
+		{
+			if (m_Count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+				return true;
+		}
+
+		return false;
+	}
+
+	/// <summary>
+	/// Releases the given amount of permits. Waiting fibers are served first in FIFO order.
+	/// </summary>
+	/// <param name="count">The amount of permits to release.</param>
+	void JobSemaphore::Release(int count)
+	{
+		JobWaitQueue resumed{};
+
+		{
+			ScopedSpinLock lock(m_Guard);
+
+			while (count > 0 && !m_Waiters.Empty())
+			{
+				resumed.Push(m_Waiters.Pop());
+				--count;
+			}
+
+			if (count > 0)
+				m_Count.fetch_add(count, std::memory_order_release);
+		}
+
+		ResumeWaiters(resumed.PopAll());
+	}
+
+	// ------------------ JobEvent ------------------
+
+	JobEvent::JobEvent(const bool initiallySet)
+		: m_Signaled(initiallySet)
+	{ }
+
+	/// <summary>
+	/// Waits until the event is set. Spins shortly and parks the calling fiber afterwards.
+	/// </summary>
+	void JobEvent::Wait()
+	{
+		for (int i = 0; i < SYNC_SPIN_COUNT(); ++i)
+		{
+			if (m_Signaled.load(std::memory_order_acquire))
+				return;
+
+			YieldProcessor();
+		}
+
+		JobWaitNode node;
+
+		{
+			ScopedSpinLock lock(m_Guard);
+
+			if (m_Signaled.load(std::memory_order_relaxed))
+				return;
+
+			m_Waiters.Push(&node);
+		}
+
+		WaitForSignal(&node.m_Counter);
+	}
+
+	/// <summary>
+	/// Sets the event and resumes all waiting fibers.
+	/// </summary>
+	void JobEvent::Set()
+	{
+		JobWaitNode* waiters = nullptr;
+
+		{
+			ScopedSpinLock lock(m_Guard);
+			m_Signaled.store(true, std::memory_order_release);
+			waiters = m_Waiters.PopAll();
+		}
+
+		ResumeWaiters(waiters);
+	}
+
+	/// <summary>
+	/// Resets the event so subsequent calls to Wait suspend again.
+	/// </summary>
+	void JobEvent::Reset()
+	{
+		ScopedSpinLock lock(m_Guard);
+		m_Signaled.store(false, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Returns whether the event is currently set.
+	/// </summary>
+	bool JobEvent::IsSet() const
+	{
+		return m_Signaled.load(std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,165 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+#include "spinlock.h"
+
+namespace Borealis::Jobs
+{
+	/// <summary>
+	/// A waiter parked on one of the fiber-aware synchronization primitives. Lives on the waiting fiber's stack.
+	/// The counter is released to 0 by the primitive in order to resume the fiber.
+	/// </summary>
+	struct JobWaitNode
+	{
+		Counter m_Counter = Counter(1);
+		JobWaitNode* m_pNext = nullptr;
+	};
+
+	/// <summary>
+	/// A FIFO list of parked waiters. Not thread safe on its own; guarded by the owning primitive.
+	/// </summary>
+	struct JobWaitQueue
+	{
+		JobWaitNode* m_pHead = nullptr;
+		JobWaitNode* m_pTail = nullptr;
+
+		bool Empty() const
+		{
+			return m_pHead == nullptr;
+		}
+
+		void Push(JobWaitNode* const node)
+		{
+			node->m_pNext = nullptr;
+
+			if (m_pTail != nullptr)
+				m_pTail->m_pNext = node;
+			else
+				m_pHead = node;
+
+			m_pTail = node;
+		}
+
+		JobWaitNode* Pop()
+		{
+			JobWaitNode* node = m_pHead;
+
+			if (node != nullptr)
+			{
+				m_pHead = node->m_pNext;
+
+				if (m_pHead == nullptr)
+					m_pTail = nullptr;
+			}
+
+			return node;
+		}
+
+		/// <summary>
+		/// Detaches the whole list in order to resume the waiters outside of the guard.
+		/// </summary>
+		JobWaitNode* PopAll()
+		{
+			JobWaitNode* head = m_pHead;
+			m_pHead = nullptr;
+			m_pTail = nullptr;
+			return head;
+		}
+	};
+
+	// Serial mode (no worker threads) runs the jobs inline and nests every wait on the main thread's stack. A wait on a
+	// primitive can therefore only be satisfied by the jobs it runs, never by a job further down the stack:
+	// - Don't hold a JobMutex or JobSemaphore permit across a WaitForCounter whose jobs contend for it.
+	// - Don't wait on a JobEvent that is only set after an outer wait returned.
+	// Both work with worker threads but hang in serial mode, which asserts in debug builds.
+
+	/// <summary>
+	/// A mutex which only suspends the contending fiber instead of the whole worker thread.
+	/// After a short spin the fiber is parked and the worker is handed back to the scheduler.
+	/// Ownership is handed over to the waiters in FIFO order.
+	/// </summary>
+	class BOREALIS_API JobMutex
+	{
+	public:
+		JobMutex() = default;
+		~JobMutex() = default;
+
+		JobMutex(const JobMutex&) = delete;
+		JobMutex& operator=(const JobMutex&) = delete;
+
+		void Lock();
+		bool TryLock();
+		void Unlock();
+
+	private:
+		SpinLock m_Guard{};
+		std::atomic<bool> m_Locked = false;
+		JobWaitQueue m_Waiters{};
+	};
+
+	/// <summary>
+	/// A counting semaphore which only suspends the contending fiber instead of the whole worker thread.
+	/// Released permits are handed over to the waiters in FIFO order.
+	/// </summary>
+	class BOREALIS_API JobSemaphore
+	{
+	public:
+		explicit JobSemaphore(const int initialCount = 0);
+		~JobSemaphore() = default;
+
+		JobSemaphore(const JobSemaphore&) = delete;
+		JobSemaphore& operator=(const JobSemaphore&) = delete;
+
+		void Acquire();
+		bool TryAcquire();
+		void Release(int count = 1);
+
+	private:
+		SpinLock m_Guard{};
+		std::atomic<int> m_Count = 0;
+		JobWaitQueue m_Waiters{};
+	};
+
+	/// <summary>
+	/// A manual reset event. Waiting fibers are suspended until the event is set and resumed in FIFO order.
+	/// </summary>
+	class BOREALIS_API JobEvent
+	{
+	public:
+		explicit JobEvent(const bool initiallySet = false);
+		~JobEvent() = default;
+
+		JobEvent(const JobEvent&) = delete;
+		JobEvent& operator=(const JobEvent&) = delete;
+
+		void Wait();
+		void Set();
+		void Reset();
+		bool IsSet() const;
+
+	private:
+		SpinLock m_Guard{};
+		std::atomic<bool> m_Signaled = false;
+		JobWaitQueue m_Waiters{};
+	};
+
+	/// <summary>
+	/// Locks the job mutex for the lifetime of the scope.
+	/// </summary>
+	struct ScopedJobLock
+	{
+		ScopedJobLock(JobMutex& _mutex)
+			: mutex(&_mutex)
+		{
+			mutex->Lock();
+		}
+
+		~ScopedJobLock()
+		{
+			mutex->Unlock();
+		}
+
+	private:
+		JobMutex* mutex = nullptr;
+	};
+}
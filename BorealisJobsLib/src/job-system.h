@@ -1,35 +1,47 @@
 #pragma once
 #include "config.h"
 #include <vector>
+#include <chrono>
 #include "job.h"
+#include "job-scheduler.h"
+#include "counter-pool.h"
+#include "sharded-counter.h"
+#include "job-cost-model.h"
 
 
 namespace Borealis::Jobs
 {
 	typedef void* LPVOID;
 
+	// The free functions drive the default scheduler (InitializeJobSystem / DeinitializeJobSystem) or the scheduler
+	// owning the calling thread, so jobs kicked from within a scheduler stay on it.
+
 	BOREALIS_API void InitializeJobSystem(int numOfThreads = -1);
 	BOREALIS_API void DeinitializeJobSystem();
 
 	BOREALIS_API void KickJob(const Job& job);
 	BOREALIS_API void KickJobs(Job* const jobs, int jobCount);
 
+	BOREALIS_API bool KickOrInline(const Job& job);
+	BOREALIS_API int KickOrInlineJobs(Job* const jobs, int jobCount);
+
 	BOREALIS_API void KickMainThreadJob(const Job& job);
 	BOREALIS_API void KickMainThreadJobs(Job* const jobs, int jobCount);
 
 	BOREALIS_API void WaitForCounter(Counter* const cnt, const int desiredCount = 0);
 	BOREALIS_API void WaitForCounterAndFree(Counter* const cnt, const int desiredCount = 0);
 
+	BOREALIS_API void WaitForCounter(const CounterHandle handle, const int desiredCount = 0);
+	BOREALIS_API void WaitForCounterAndFree(const CounterHandle handle, const int desiredCount = 0);
+
+	BOREALIS_API void WaitForCounter(ShardedCounter& cnt);
+
+	BOREALIS_API void WaitForSignal(Counter* const cnt, const int desiredCount = 0);
+
+	BOREALIS_API void SetMaxJobBatchSize(const int maxBatchSize);
+	BOREALIS_API void SetMainThreadStealBudget(const std::chrono::microseconds budget);
+
 	// --------------------------------------------------------
 
 	void ForceMainThreadExecution();
-	Job	 GetNextJob();
-	void CheckWaitList();
-	VOID RunFiber();
-	LPVOID GetFiber();
-	void RunThread();
-	void CreateFiberPool();
-	void CreateThreadPool(const int numOfThreads);
-	void ReturnFiber(const LPVOID fiber);
-	void UpdateWaitData();
 }
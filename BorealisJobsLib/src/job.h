@@ -19,6 +19,8 @@ namespace Borealis::Jobs
 	typedef std::function<JobReturnType(uintptr_t args)> JobEntryPoint;
 	typedef std::atomic<int> Counter;
 
+	class ShardedCounter;
+
 #define PARALLEL_JOB(entryPoint, priority, ...) Job(entryPoint, priority, #entryPoint, __VA_ARGS__)
 #define JOB(entryPoint, counter, priority, ...) Job(entryPoint, counter, priority, #entryPoint, __VA_ARGS__)
 #define BIND(func, instance, ...) std::bind(&func, &instance, __VA_ARGS__)
@@ -41,6 +43,7 @@ namespace Borealis::Jobs
 		LPVOID m_Fiber = NULL;					// 8 bytes
 		uintptr_t m_Param = NULL;				// 8 bytes
 		Counter* m_pCounter = nullptr;			// 8 bytes
+		ShardedCounter* m_pShardedCounter = nullptr;	// 8 bytes
 
 		unsigned int m_DesiredCount = 0;		// 4 bytes
 		Priority m_Priority = (Priority)1;		// 4 bytes
@@ -59,6 +62,10 @@ namespace Borealis::Jobs
 			: m_EntryPoint(ep), m_Param(args), m_pCounter(pCnt), m_Priority(pr), m_FunctionName(functionName)
 		{ }
 
+		Job(JobEntryPoint ep, ShardedCounter& cnt, Priority pr, std::string functionName, uintptr_t args = 0)
+			: m_EntryPoint(ep), m_Param(args), m_pShardedCounter(&cnt), m_Priority(pr), m_FunctionName(functionName)
+		{ }
+
 		/// <summary>
 		/// Explicitly copies the job - only used for debug purposes currently.
 		/// </summary>
@@ -69,6 +76,7 @@ namespace Borealis::Jobs
 			cpy.m_DesiredCount = m_DesiredCount;
 			cpy.m_Fiber = m_Fiber;
 			cpy.m_pCounter = m_pCounter;
+			cpy.m_pShardedCounter = m_pShardedCounter;
 
 			return cpy;
 		}
@@ -79,6 +87,7 @@ namespace Borealis::Jobs
 			, m_Fiber(other.m_Fiber)
 			, m_Param(other.m_Param)
 			, m_pCounter(other.m_pCounter)
+			, m_pShardedCounter(other.m_pShardedCounter)
 			, m_DesiredCount(other.m_DesiredCount)
 			, m_Priority(other.m_Priority)
 			, m_FunctionName(other.m_FunctionName)
@@ -92,6 +101,7 @@ namespace Borealis::Jobs
 			m_Fiber = other.m_Fiber;
 			m_Param = other.m_Param;
 			m_pCounter = other.m_pCounter;
+			m_pShardedCounter = other.m_pShardedCounter;
 			m_DesiredCount = other.m_DesiredCount;
 			m_Priority = other.m_Priority;
 			m_FunctionName = other.m_FunctionName;
@@ -105,6 +115,7 @@ namespace Borealis::Jobs
 			, m_Fiber(other.m_Fiber)
 			, m_Param(other.m_Param)
 			, m_pCounter(other.m_pCounter)
+			, m_pShardedCounter(other.m_pShardedCounter)
 			, m_DesiredCount(other.m_DesiredCount)
 			, m_Priority(other.m_Priority)
 			, m_FunctionName(other.m_FunctionName)
@@ -113,6 +124,7 @@ namespace Borealis::Jobs
 			other.m_Fiber = NULL;
 			other.m_Param = NULL;
 			other.m_pCounter = nullptr;
+			other.m_pShardedCounter = nullptr;
 			other.m_DesiredCount = 0;
 			other.m_Priority = Priority::NORMAL;
 			other.m_FunctionName = "";
@@ -124,6 +136,7 @@ namespace Borealis::Jobs
 			m_Fiber = other.m_Fiber;
 			m_Param = other.m_Param;
 			m_pCounter = other.m_pCounter;
+			m_pShardedCounter = other.m_pShardedCounter;
 			m_DesiredCount = other.m_DesiredCount;
 			m_Priority = other.m_Priority;
 			m_FunctionName = other.m_FunctionName;
@@ -132,6 +145,7 @@ namespace Borealis::Jobs
 			other.m_Fiber = NULL;
 			other.m_Param = NULL;
 			other.m_pCounter = nullptr;
+			other.m_pShardedCounter = nullptr;
 			other.m_DesiredCount = 0;
 			other.m_Priority = Priority::NORMAL;
 			other.m_FunctionName = "";
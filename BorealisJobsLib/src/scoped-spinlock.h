@@ -3,9 +3,10 @@
 
 namespace Borealis::Jobs 
 {
+	template<typename LockType = SpinLock>
 	struct ScopedSpinLock
 	{
-		ScopedSpinLock(const SpinLock& _spinlock) noexcept
+		ScopedSpinLock(const LockType& _spinlock) noexcept
 			: spinlock(&_spinlock)
 		{
 			spinlock->Acquire();
@@ -17,6 +18,6 @@ namespace Borealis::Jobs
 		}
 
 	private:
-		SpinLock const* spinlock = nullptr;
+		LockType const* spinlock = nullptr;
 	};
 }
@@ -0,0 +1,123 @@
+#include "sharded-counter.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <thread>
+
+namespace Borealis::Jobs
+{
+	// Hands out the shard hints round robin, so the threads spread evenly across the shards.
+	std::atomic<int> g_nextShardHint(0);
+
+	// The shard the calling thread starts looking at, -1 until the thread decremented a sharded counter for the first time.
+	thread_local int t_shardHint = -1;
+
+	/// <summary>
+	/// Returns the shard hint of the calling thread. Never inlined, since a fiber might continue on another thread
+	/// and must not reuse a cached thread local address.
+	/// </summary>
+	static __declspec(noinline) int GetShardHint()
+	{
+		if (t_shardHint < 0)
+			t_shardHint = g_nextShardHint.fetch_add(1, std::memory_order_relaxed);
+
+		return t_shardHint;
+	}
+
+	ShardedCounter::ShardedCounter(const int initialCount)
+		: m_NumShards(std::clamp((int)std::thread::hardware_concurrency(), 1, MAX_COUNTER_SHARDS()))
+	{
+		m_pShards = new Shard[m_NumShards];
+		Reset(initialCount);
+	}
+
+	ShardedCounter::~ShardedCounter()
+	{
+		delete[] m_pShards;
+	}
+
+	/// <summary>
+	/// Distributes the count evenly across the shards. Must not be called while children are still running.
+	/// </summary>
+	/// <param name="count">The amount of children to wait for.</param>
+	void ShardedCounter::Reset(const int count)
+	{
+		assert(count >= 0);
+
+		const int share = count / m_NumShards;
+		const int remainder = count % m_NumShards;
+		int nonEmptyShards = 0;
+
+		for (int i = 0; i < m_NumShards; ++i)
+		{
+			const int shardCount = share + (i < remainder ? 1 : 0);
+			m_pShards[i].m_Remaining.store(shardCount, std::memory_order_relaxed);
+
+			if (shardCount > 0)
+				++nonEmptyShards;
+		}
+
+		m_Root.store(nonEmptyShards, std::memory_order_release);
+	}
+
+	/// <summary>
+	/// Signals a finished child. Consumes a unit of the calling thread's shard or, if that one is exhausted,
+	/// of the next shard with units left. The child exhausting a shard propagates it to the root.
+	/// </summary>
+	void ShardedCounter::Decrement()
+	{
+		const int hint = GetShardHint();
+
+		for (int i = 0; i < m_NumShards; ++i)
+		{
+			Shard& shard = m_pShards[(hint + i) % m_NumShards];
+
+			// Plain load first, so exhausted shards stay shared in the caches of all probing threads
+			int remaining = shard.m_Remaining.load(std::memory_order_relaxed);
+
+			while (remaining > 0)
+			{
+				// Acquire as well: The child exhausting the shard publishes the work of every child of the shard to the root
+				if (!shard.m_Remaining.compare_exchange_weak(remaining, remaining - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+					continue;
+
+				if (remaining == 1)
+					m_Root.fetch_sub(1, std::memory_order_acq_rel);
+
+				return;
+			}
+		}
+
+		assert(false && "More children finished than the sharded counter was set up for!");
+	}
+
+	/// <summary>
+	/// Returns the amount of children that didn't finish yet. Only a snapshot while children are running.
+	/// </summary>
+	int ShardedCounter::GetCount() const
+	{
+		int count = 0;
+
+		for (int i = 0; i < m_NumShards; ++i)
+		{
+			count += m_pShards[i].m_Remaining.load(std::memory_order_relaxed);
+		}
+
+		return count;
+	}
+
+	int ShardedCounter::GetNumShards() const
+	{
+		return m_NumShards;
+	}
+
+	bool ShardedCounter::IsDone() const
+	{
+		return m_Root.load(std::memory_order_acquire) == 0;
+	}
+
+	Counter* ShardedCounter::GetRoot()
+	{
+		return &m_Root;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "config.h"
+#include "job.h"
+
+namespace Borealis::Jobs
+{
+	/// <summary>
+	/// A fan-in counter for very wide fan-outs. Instead of thousands of children hammering a single atomic, the count
+	/// is split into per-thread shards on cache lines of their own, which form a two level tree with the root:
+	/// - Every child consumes one unit of the shard of its thread and only touches other shards once that one is exhausted.
+	/// - The root counts the shards that still have units left, so it is only written once per shard.
+	/// Children are attached with JOB(entryPoint, shardedCounter, priority). Waiters (WaitForCounter) only ever read the root, which reaches 0 once every child finished.
+	/// </summary>
+	class BOREALIS_API ShardedCounter
+	{
+	public:
+		/// <summary>
+		/// Creates a counter for the given amount of children.
+		/// </summary>
+		/// <param name="initialCount">The amount of children to wait for.</param>
+		explicit ShardedCounter(const int initialCount = 0);
+		~ShardedCounter();
+
+		ShardedCounter(const ShardedCounter&) = delete;
+		ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+		void Reset(const int count);
+		void Decrement();
+
+		int GetCount() const;
+		int GetNumShards() const;
+		bool IsDone() const;
+
+		/// <summary>
+		/// Returns the root, which is 0 once every child finished. Only meant to be waited on!
+		/// </summary>
+		Counter* GetRoot();
+
+	private:
+		struct alignas(CACHE_LINE_SIZE()) Shard
+		{
+			std::atomic<int> m_Remaining = 0;
+		};
+
+		Shard* m_pShards = nullptr;
+		int m_NumShards = 0;
+
+		alignas(CACHE_LINE_SIZE()) Counter m_Root = Counter(0);
+	};
+}
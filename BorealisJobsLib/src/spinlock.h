@@ -1,9 +1,25 @@
 #pragma once
+#include "config.h"
 #include <atomic>
 #include <mutex>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BOREALIS_CPU_PAUSE() _mm_pause()
+#elif defined(_M_ARM64) || defined(_M_ARM)
+#include <intrin.h>
+#define BOREALIS_CPU_PAUSE() __yield()
+#else
+#define BOREALIS_CPU_PAUSE() ((void)0)
+#endif
 
 namespace Borealis::Jobs
 {
+	/// <summary>
+	/// A test-and-test-and-set spinlock with exponential backoff. Contenders only read the lock while spinning
+	/// and fall back to waiting on the atomic after a while. Releasing only notifies if somebody is actually waiting.
+	/// </summary>
 	struct SpinLock
 	{
 		SpinLock() = default;
@@ -11,18 +27,109 @@ namespace Borealis::Jobs
 
 		__forceinline void Acquire() const noexcept
 		{
-			// Guard
-			while (lock.test_and_set(std::memory_order_seq_cst))
-				lock.wait(true, std::memory_order_relaxed);
+			// Uncontended fast path
+			int expected = UNLOCKED;
+			if (state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+				return;
+
+			AcquireContended();
+		}
+
+		__forceinline bool TryAcquire() const noexcept
+		{
+			int expected = UNLOCKED;
+			return state.load(std::memory_order_relaxed) == UNLOCKED
+				&& state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
 		}
 
 		__forceinline void Release() const noexcept
 		{
-			lock.clear(std::memory_order_release);
-			lock.notify_one();
+			// Only pay for the notification if a waiter announced itself
+			if (state.exchange(UNLOCKED, std::memory_order_release) == CONTENDED)
+				state.notify_one();
 		}
 
 	private:
-		mutable std::atomic_flag lock = ATOMIC_FLAG_INIT;
+		static constexpr int UNLOCKED = 0;
+		static constexpr int LOCKED = 1;
+		static constexpr int CONTENDED = 2;		// Locked and at least one thread may be waiting
+
+		static constexpr int MAX_BACKOFF = 64;
+		static constexpr int SPIN_LIMIT = 1024;
+
+		void AcquireContended() const noexcept
+		{
+			// Spin on a plain load so the cache line stays shared until the lock is released
+			int backoff = 1;
+			for (int spins = 0; spins < SPIN_LIMIT; spins += backoff)
+			{
+				for (int i = 0; i < backoff; ++i)
+					BOREALIS_CPU_PAUSE();
+
+				if (backoff < MAX_BACKOFF)
+					backoff <<= 1;
+
+				if (TryAcquire())
+					return;
+			}
+
+			// Announce ourselves as waiter and sleep until the owner releases the lock
+			while (state.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED)
+				state.wait(CONTENDED, std::memory_order_relaxed);
+		}
+
+		mutable std::atomic<int> state = UNLOCKED;
+	};
+
+	/// <summary>
+	/// A fair ticket lock for heavily contended internal structures. Threads acquire the lock strictly in
+	/// the order they arrived in and back off proportionally to their distance to the head of the queue.
+	/// Never sleeps, so only use it for short critical sections!
+	/// </summary>
+	struct TicketSpinLock
+	{
+		TicketSpinLock() = default;
+		~TicketSpinLock() = default;
+
+		__forceinline void Acquire() const noexcept
+		{
+			const unsigned int ticket = next.fetch_add(1, std::memory_order_relaxed);
+			unsigned int spins = 0;
+
+			while (true)
+			{
+				const unsigned int current = serving.load(std::memory_order_acquire);
+				if (current == ticket)
+					return;
+
+				// Wait longer the further back in line we are
+				const unsigned int distance = ticket - current;
+				for (unsigned int i = 0; i < distance * BACKOFF_PER_WAITER; ++i)
+					BOREALIS_CPU_PAUSE();
+
+				// Give the owner a chance to run in case it got preempted
+				if (++spins > YIELD_THRESHOLD)
+					std::this_thread::yield();
+			}
+		}
+
+		__forceinline bool TryAcquire() const noexcept
+		{
+			unsigned int current = serving.load(std::memory_order_relaxed);
+			return next.compare_exchange_strong(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed);
+		}
+
+		__forceinline void Release() const noexcept
+		{
+			serving.store(serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+	private:
+		static constexpr unsigned int BACKOFF_PER_WAITER = 16;
+		static constexpr unsigned int YIELD_THRESHOLD = 64;
+
+		// Arriving threads and the spinning waiters must not invalidate each others cache line
+		alignas(CACHE_LINE_SIZE()) mutable std::atomic<unsigned int> next = 0;
+		alignas(CACHE_LINE_SIZE()) mutable std::atomic<unsigned int> serving = 0;
 	};
-}
\ No newline at end of file
+}
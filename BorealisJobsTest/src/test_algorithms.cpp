@@ -0,0 +1,115 @@
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "../../src/job-system.h"
+#include "../../src/job-algorithms.h"
+
+#ifdef BOREALIS_WIN
+
+using namespace Borealis::Jobs;
+
+// Large enough to be split into many blocks and merge passes
+static constexpr size_t ELEMENT_COUNT = 1 << 20;
+
+static std::vector<int> CreateRandomValues(const size_t count, const int maxValue)
+{
+    std::mt19937 generator(1337);
+    std::uniform_int_distribution<int> distribution(0, maxValue);
+
+    std::vector<int> values(count);
+    for (int& value : values)
+    {
+        value = distribution(generator);
+    }
+
+    return values;
+}
+
+TEST(BorealisJobsAlgorithmTest, TestParallelSort)
+{
+    InitializeJobSystem();
+
+    std::vector<int> values = CreateRandomValues(ELEMENT_COUNT, 1 << 30);
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    ParallelSort(values.begin(), values.end());
+    EXPECT_EQ(values, expected);
+
+    // Custom ordering and lots of duplicates
+    values = CreateRandomValues(ELEMENT_COUNT + 123, 100);
+    expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+
+    ParallelSort(values.begin(), values.end(), std::greater<>());
+    EXPECT_EQ(values, expected);
+
+    // Below the serial threshold
+    values = CreateRandomValues(1000, 1000);
+    expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    ParallelSort(values.begin(), values.end());
+    EXPECT_EQ(values, expected);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsAlgorithmTest, TestParallelScan)
+{
+    InitializeJobSystem();
+
+    const std::vector<int> values = CreateRandomValues(ELEMENT_COUNT + 77, 100);
+
+    std::vector<long long> expected(values.size());
+    std::vector<long long> result(values.size());
+
+    std::inclusive_scan(values.begin(), values.end(), expected.begin(), std::plus<long long>());
+    ParallelInclusiveScan(values.begin(), values.end(), result.begin(), std::plus<long long>());
+    EXPECT_EQ(result, expected);
+
+    std::exclusive_scan(values.begin(), values.end(), expected.begin(), 42ll, std::plus<long long>());
+    ParallelExclusiveScan(values.begin(), values.end(), result.begin(), 42ll, std::plus<long long>());
+    EXPECT_EQ(result, expected);
+
+    // In place
+    std::vector<int> inPlace = values;
+    std::vector<int> inPlaceExpected(values.size());
+    std::inclusive_scan(values.begin(), values.end(), inPlaceExpected.begin());
+    ParallelInclusiveScan(inPlace.begin(), inPlace.end(), inPlace.begin());
+    EXPECT_EQ(inPlace, inPlaceExpected);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsAlgorithmTest, TestParallelStablePartition)
+{
+    InitializeJobSystem();
+
+    const std::vector<int> keys = CreateRandomValues(ELEMENT_COUNT + 5, 1000);
+
+    // The index tracks the original order to verify the stability
+    std::vector<std::pair<int, size_t>> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        values[i] = { keys[i], i };
+    }
+
+    std::vector<std::pair<int, size_t>> expected = values;
+
+    auto isEven = [](const std::pair<int, size_t>& value) { return value.first % 2 == 0; };
+
+    const auto expectedPoint = std::stable_partition(expected.begin(), expected.end(), isEven);
+    const auto point = ParallelStablePartition(values.begin(), values.end(), isEven);
+
+    EXPECT_EQ(point - values.begin(), expectedPoint - expected.begin());
+    EXPECT_EQ(values, expected);
+
+    DeinitializeJobSystem();
+}
+
+#endif
@@ -0,0 +1,170 @@
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+#include "../../src/job-system.h"
+#include "../../src/job-cost-model.h"
+
+#ifdef BOREALIS_WIN
+
+using namespace Borealis::Jobs;
+
+TEST(BorealisJobsCostModelTest, TestMovingAverage)
+{
+    ResetJobCosts();
+
+    double estimateNs = 0.0;
+    EXPECT_FALSE(GetJobCostEstimate("MovingAverageJob", estimateNs));
+
+    // The first sample is taken as is...
+    RecordJobCost("MovingAverageJob", 1000.0);
+    ASSERT_TRUE(GetJobCostEstimate("MovingAverageJob", estimateNs));
+    EXPECT_DOUBLE_EQ(estimateNs, 1000.0);
+
+    // ...and the average follows a changed cost
+    for (int i = 0; i < 200; ++i)
+    {
+        RecordJobCost("MovingAverageJob", 5000.0);
+    }
+
+    ASSERT_TRUE(GetJobCostEstimate("MovingAverageJob", estimateNs));
+    EXPECT_NEAR(estimateNs, 5000.0, 1.0);
+
+    // Unnamed jobs are never learned
+    RecordJobCost("", 1000.0);
+    EXPECT_FALSE(GetJobCostEstimate("", estimateNs));
+
+    ResetJobCosts();
+    EXPECT_FALSE(GetJobCostEstimate("MovingAverageJob", estimateNs));
+}
+
+TEST(BorealisJobsCostModelTest, TestDumpAndPreload)
+{
+    ResetJobCosts();
+
+    RecordJobCost("DumpedJob", 250.0);
+    RecordJobCost("[&](uintptr_t) { Other(); }", 80000.0);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "borealis_job_costs.txt").string();
+    ASSERT_TRUE(SaveJobCosts(path.c_str()));
+
+    const std::vector<JobCost> dumped = DumpJobCosts();
+    EXPECT_EQ(dumped.size(), (size_t)2);
+
+    // A warm start knows the costs before the first job ran
+    ResetJobCosts();
+    ASSERT_TRUE(LoadJobCosts(path.c_str()));
+    std::remove(path.c_str());
+
+    double estimateNs = 0.0;
+    ASSERT_TRUE(GetJobCostEstimate("DumpedJob", estimateNs));
+    EXPECT_NEAR(estimateNs, 250.0, 0.1);
+    ASSERT_TRUE(GetJobCostEstimate("[&](uintptr_t) { Other(); }", estimateNs));
+    EXPECT_NEAR(estimateNs, 80000.0, 0.1);
+
+    // Preloaded costs are smoothed instead of replaced by the next sample
+    PreloadJobCosts({ JobCost{ "PreloadedJob", 400.0, 10 } });
+    RecordJobCost("PreloadedJob", 1200.0);
+    ASSERT_TRUE(GetJobCostEstimate("PreloadedJob", estimateNs));
+    EXPECT_GT(estimateNs, 400.0);
+    EXPECT_LT(estimateNs, 1200.0);
+
+    ResetJobCosts();
+}
+
+TEST(BorealisJobsCostModelTest, TestKickOrInline)
+{
+    InitializeJobSystem();
+    ResetJobCosts();
+
+    const std::thread::id callerId = std::this_thread::get_id();
+    std::atomic<int> inlineJobs = 0;
+
+    auto tinyJob = [&](uintptr_t)
+    {
+        if (std::this_thread::get_id() == callerId)
+            ++inlineJobs;
+    };
+
+    auto hugeJob = [](uintptr_t)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < std::chrono::microseconds(200)) { }
+    };
+
+    // Unknown job types are always kicked
+    Counter counter = Counter(1);
+    EXPECT_FALSE(KickOrInline(JOB(tinyJob, &counter, Priority::NORMAL)));
+    WaitForCounter(&counter);
+
+    PreloadJobCosts({ JobCost{ "tinyJob", 50.0, 1 }, JobCost{ "hugeJob", 200000.0, 1 } });
+
+    // Tiny jobs run inline and still signal their counter
+    counter = 1;
+    inlineJobs = 0;
+    EXPECT_TRUE(KickOrInline(JOB(tinyJob, &counter, Priority::NORMAL)));
+    EXPECT_EQ(counter.load(), 0);
+    EXPECT_EQ(inlineJobs.load(), 1);
+
+    counter = 1;
+    EXPECT_FALSE(KickOrInline(JOB(hugeJob, &counter, Priority::NORMAL)));
+    WaitForCounter(&counter);
+
+    // Mixed batches are split into kicked and inlined jobs
+    static constexpr int jobCount = 16;
+
+    std::vector<Job> jobs;
+    counter = jobCount;
+    for (int i = 0; i < jobCount; ++i)
+    {
+        jobs.push_back(i % 2 == 0 ? JOB(tinyJob, &counter, Priority::NORMAL) : JOB(hugeJob, &counter, Priority::NORMAL));
+    }
+
+    EXPECT_EQ(KickOrInlineJobs(jobs.data(), jobCount), jobCount / 2);
+    WaitForCounter(&counter);
+
+    ResetJobCosts();
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsCostModelTest, TestParkedTimeExcluded)
+{
+    InitializeJobSystem(1);
+
+    if (JobScheduler::Default().GetNumWorkers() == 0)
+    {
+        DeinitializeJobSystem();
+        GTEST_SKIP() << "Jobs don't park in serial mode";
+    }
+
+    ResetJobCosts();
+
+    static constexpr int jobCount = 16;
+
+    Counter gate = Counter(1);
+    auto parkingJob = [&](uintptr_t) { WaitForCounter(&gate); };
+
+    // Every job parks far longer than it runs
+    Counter counter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        KickJob(JOB(parkingJob, &counter, Priority::NORMAL));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    gate.fetch_sub(1);
+    WaitForCounter(&counter);
+
+    double estimateNs = 0.0;
+    ASSERT_TRUE(GetJobCostEstimate("parkingJob", estimateNs));
+    EXPECT_LT(estimateNs, 10000000.0);
+
+    ResetJobCosts();
+    DeinitializeJobSystem();
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include <vector>
+#include <atomic>
+
+#include <gtest/gtest.h>
+#include "../../src/job-system.h"
+#include "../../src/counter-pool.h"
+
+#ifdef BOREALIS_WIN
+
+using namespace Borealis::Jobs;
+
+TEST(BorealisJobsCounterTest, TestStaleHandleDetection)
+{
+    const int allocatedBefore = GetNumAllocatedCounters();
+
+    CounterHandle handle = AllocateCounter(3);
+    ASSERT_TRUE(handle.IsValid());
+    ASSERT_NE(GetCounter(handle), nullptr);
+    EXPECT_EQ(GetCounter(handle)->load(), 3);
+    EXPECT_EQ(GetNumAllocatedCounters(), allocatedBefore + 1);
+
+    ReleaseCounter(handle);
+    EXPECT_EQ(GetCounter(handle), nullptr);
+    EXPECT_EQ(GetNumAllocatedCounters(), allocatedBefore);
+
+    // The slot gets reused, but the old handle stays stale
+    CounterHandle recycled = AllocateCounter(1);
+    EXPECT_EQ(recycled.m_Index, handle.m_Index);
+    EXPECT_NE(recycled.m_Generation, handle.m_Generation);
+    EXPECT_EQ(GetCounter(handle), nullptr);
+    EXPECT_NE(GetCounter(recycled), nullptr);
+
+    ReleaseCounter(recycled);
+    EXPECT_EQ(GetCounter(CounterHandle{}), nullptr);
+}
+
+TEST(BorealisJobsCounterTest, TestCountersRecycledByLastWaiter)
+{
+    InitializeJobSystem();
+
+    static constexpr int waiterCount = 4;
+
+    const int allocatedBefore = GetNumAllocatedCounters();
+    std::atomic<int> resumed = 0;
+
+    auto childJob = [](uintptr_t) { };
+
+    // Every waiter frees the shared counter, only the last one recycles it
+    CounterHandle shared = AllocateCounter(1, waiterCount);
+
+    auto waitingJob = [&](uintptr_t)
+    {
+        WaitForCounterAndFree(shared);
+        resumed.fetch_add(1);
+    };
+
+    Counter waiterCounter = Counter(waiterCount);
+    for (int i = 0; i < waiterCount; ++i)
+    {
+        KickJob(JOB(waitingJob, &waiterCounter, Priority::NORMAL));
+    }
+
+    KickJob(JOB(childJob, GetCounter(shared), Priority::LOW));
+    WaitForCounter(&waiterCounter);
+
+    EXPECT_EQ(resumed.load(), waiterCount);
+    EXPECT_EQ(GetCounter(shared), nullptr);
+    EXPECT_EQ(GetNumAllocatedCounters(), allocatedBefore);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsCounterTest, TestWaitAndFreeReturnsFibers)
+{
+    InitializeJobSystem();
+
+    // Single core hosts run in serial mode, which creates no fibers at all
+    if (JobScheduler::Default().GetNumWorkers() == 0)
+    {
+        DeinitializeJobSystem();
+        GTEST_SKIP() << "The serial mode has no fiber pool";
+    }
+
+    // Far more suspending waits than there are fibers, which would exhaust a leaking pool
+    static constexpr int rounds = NUM_FIBERS() * 2;
+    static constexpr int jobCount = 4;
+
+    std::atomic<int> executed = 0;
+
+    auto childJob = [&](uintptr_t)
+    {
+        executed.fetch_add(1);
+    };
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        CounterHandle handle = AllocateCounter(jobCount);
+
+        for (int i = 0; i < jobCount; ++i)
+        {
+            KickJob(JOB(childJob, GetCounter(handle), Priority::NORMAL));
+        }
+
+        WaitForCounterAndFree(handle);
+
+        // The legacy heap counter path must not leak either
+        Counter* heapCounter = new Counter(1);
+        KickJob(JOB(childJob, heapCounter, Priority::NORMAL));
+        WaitForCounterAndFree(heapCounter);
+    }
+
+    EXPECT_EQ(executed.load(), rounds * (jobCount + 1));
+    // Every worker holds at most one fiber. Since the waiting main thread helps out, a worker might not even have started yet.
+    EXPECT_GE(JobScheduler::Default().GetNumPooledFibers(), NUM_FIBERS() - JobScheduler::Default().GetNumWorkers());
+
+    DeinitializeJobSystem();
+}
+
+#endif
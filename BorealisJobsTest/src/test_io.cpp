@@ -0,0 +1,84 @@
+#include <vector>
+#include <cstdio>
+
+#include <gtest/gtest.h>
+#include "../../src/job-system.h"
+#include "../../src/job-io.h"
+
+#ifdef BOREALIS_WIN
+
+using namespace Borealis::Jobs;
+
+TEST(BorealisJobsIoTest, TestAsyncWriteAndRead)
+{
+    InitializeJobSystem();
+
+    const char* path = "borealis_async_io_test.bin";
+
+    std::vector<char> data(64 * 1024);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (char)(i % 251);
+    }
+
+    std::vector<char> readBack(data.size(), 0);
+    bool writeSucceeded = false;
+    bool readSucceeded = false;
+    unsigned long bytesWritten = 0;
+    unsigned long bytesRead = 0;
+
+    auto ioJob = [&](uintptr_t)
+    {
+        HANDLE file = OpenAsyncFile(path, true);
+        ASSERT_NE(file, INVALID_HANDLE_VALUE);
+        writeSucceeded = AsyncWrite(file, data.data(), (unsigned long)data.size(), 0, &bytesWritten);
+        CloseHandle(file);
+
+        file = OpenAsyncFile(path);
+        ASSERT_NE(file, INVALID_HANDLE_VALUE);
+        readSucceeded = AsyncRead(file, readBack.data(), (unsigned long)readBack.size(), 0, &bytesRead);
+        CloseHandle(file);
+    };
+
+    Counter jobCounter = Counter(1);
+    KickJob(JOB(ioJob, &jobCounter, Priority::NORMAL));
+    WaitForCounter(&jobCounter);
+
+    EXPECT_TRUE(writeSucceeded);
+    EXPECT_TRUE(readSucceeded);
+    EXPECT_EQ(bytesWritten, data.size());
+    EXPECT_EQ(bytesRead, data.size());
+    EXPECT_EQ(data, readBack);
+    EXPECT_EQ(jobCounter, 0);
+
+    DeinitializeJobSystem();
+    std::remove(path);
+}
+
+TEST(BorealisJobsIoTest, TestAsyncReadPastEndOfFile)
+{
+    InitializeJobSystem();
+
+    const char* path = "borealis_async_io_eof_test.bin";
+    const char payload[] = "borealis";
+
+    HANDLE file = OpenAsyncFile(path, true);
+    ASSERT_NE(file, INVALID_HANDLE_VALUE);
+    EXPECT_TRUE(AsyncWrite(file, payload, sizeof(payload)));
+    CloseHandle(file);
+
+    // Reading from the main fiber parks it just like WaitForCounter does
+    char buffer[16] = {};
+    unsigned long bytesRead = 1;
+
+    file = OpenAsyncFile(path);
+    ASSERT_NE(file, INVALID_HANDLE_VALUE);
+    EXPECT_FALSE(AsyncRead(file, buffer, sizeof(buffer), 4096, &bytesRead));
+    EXPECT_EQ(bytesRead, 0);
+    CloseHandle(file);
+
+    DeinitializeJobSystem();
+    std::remove(path);
+}
+
+#endif
@@ -2,9 +2,14 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
 
 #include <gtest/gtest.h>
 #include "../../src/job-system.h"
+#include "../../src/job-sync.h"
 
 #ifdef BOREALIS_WIN
 
@@ -166,6 +171,637 @@ TEST(BorealisJobsTest, TestBatchJobs)
 TEST(BorealisJobsTest, TestHierarchicalJobs)
 {
     // Test jobs waiting on jobs waiting on jobs ...
+    InitializeJobSystem();
+
+    static constexpr int childCount = 4;
+    static constexpr int grandChildCount = 4;
+
+    std::atomic<int> executedGrandChildren = 0;
+
+    auto grandChildJob = [&](uintptr_t seed)
+    {
+        DoWork(seed);
+        executedGrandChildren.fetch_add(1);
+    };
+
+    auto childJob = [&](uintptr_t seed)
+    {
+        Counter grandChildCounter = Counter(grandChildCount);
+
+        for (int i = 0; i < grandChildCount; ++i)
+        {
+            KickJob(JOB(grandChildJob, &grandChildCounter, Priority::NORMAL, seed + i));
+        }
+
+        WaitForCounter(&grandChildCounter);
+        EXPECT_EQ(grandChildCounter, 0);
+    };
+
+    Counter jobCounter = Counter(childCount);
+    for (int i = 0; i < childCount; ++i)
+    {
+        KickJob(JOB(childJob, &jobCounter, Priority::HIGH, 100 * i));
+    }
+
+    WaitForCounter(&jobCounter);
+
+    EXPECT_EQ(jobCounter, 0);
+    EXPECT_EQ(executedGrandChildren.load(), childCount * grandChildCount);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestMicroJobBatching)
+{
+    InitializeJobSystem();
+
+    static constexpr int jobCount = 20000;
+
+    // Every job has to be executed exactly once, no matter how the workers batch them
+    std::vector<std::atomic<int>> executions(jobCount);
+
+    auto microJob = [&](uintptr_t index)
+    {
+        executions[index].fetch_add(1);
+    };
+
+    std::vector<Job> jobs;
+    jobs.reserve(jobCount);
+
+    Counter jobCounter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        jobs.push_back(JOB(microJob, &jobCounter, Priority::NORMAL, (uintptr_t)i));
+    }
+
+    KickJobs(jobs.data(), jobCount);
+    WaitForCounter(&jobCounter);
+
+    EXPECT_EQ(jobCounter, 0);
+
+    int executedOnce = 0;
+    for (const std::atomic<int>& execution : executions)
+    {
+        executedOnce += execution.load() == 1 ? 1 : 0;
+    }
+    EXPECT_EQ(executedOnce, jobCount);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestSerialExecution)
+{
+    // No worker threads -> Every job runs inline on the main thread while it waits.
+    InitializeJobSystem(0);
+
+    const std::thread::id mainThreadId = std::this_thread::get_id();
+
+    std::atomic<int> executedJobs = 0;
+    std::atomic<bool> ranOnOtherThread = false;
+
+    auto leafJob = [&](uintptr_t)
+    {
+        if (std::this_thread::get_id() != mainThreadId)
+            ranOnOtherThread = true;
+
+        executedJobs.fetch_add(1);
+    };
+
+    auto nestedJob = [&](uintptr_t)
+    {
+        Counter childCounter = Counter(2);
+        KickJob(JOB(leafJob, &childCounter, Priority::LOW));
+        KickMainThreadJob(JOB(leafJob, &childCounter, Priority::NORMAL));
+        WaitForCounter(&childCounter);
+
+        EXPECT_EQ(childCounter, 0);
+        executedJobs.fetch_add(1);
+    };
+
+    Counter jobCounter = Counter(3);
+    KickJob(JOB(nestedJob, &jobCounter, Priority::HIGH));
+    KickJob(JOB(leafJob, &jobCounter, Priority::NORMAL));
+    KickJob(JOB(nestedJob, &jobCounter, Priority::LOW));
+
+    // Nothing runs before somebody waits
+    EXPECT_EQ(executedJobs.load(), 0);
+
+    WaitForCounter(&jobCounter);
+
+    EXPECT_EQ(jobCounter, 0);
+    EXPECT_EQ(executedJobs.load(), 7);
+    EXPECT_FALSE(ranOnOtherThread);
+
+    DeinitializeJobSystem();
+}
+
+#ifndef NDEBUG
+TEST(BorealisJobsTest, TestSerialNestedDeadlockAsserts)
+{
+    // The nested wait of the job can only be released by the frame below it, which never continues in serial mode
+    auto deadlock = []()
+    {
+        InitializeJobSystem(0);
+
+        JobMutex mutex;
+        ScopedJobLock outerLock(mutex);
+
+        auto lockingJob = [&](uintptr_t) { ScopedJobLock innerLock(mutex); };
+
+        Counter jobCounter = Counter(1);
+        KickJob(JOB(lockingJob, &jobCounter, Priority::NORMAL));
+        WaitForCounter(&jobCounter);
+    };
+
+    EXPECT_DEATH(deadlock(), "Serial mode deadlock");
+}
+#endif
+
+TEST(BorealisJobsTest, TestIndependentSchedulers)
+{
+    InitializeJobSystem();
+
+    // A second pool next to the default scheduler, which does not take over the calling thread
+    JobSchedulerDesc desc{};
+    desc.m_NumOfThreads = 2;
+    desc.m_AdoptCallingThread = false;
+
+    JobScheduler pool;
+    pool.Initialize(desc);
+
+    // The thread count is clamped to the logical cores, but a pool without a main thread always gets a worker
+    const int expectedWorkers = std::thread::hardware_concurrency() >= 2 ? 2 : 1;
+    EXPECT_EQ(pool.GetNumWorkers(), expectedWorkers);
+
+    static constexpr int jobCount = 16;
+
+    std::atomic<int> poolJobs = 0;
+    std::atomic<int> defaultJobs = 0;
+    std::atomic<bool> wrongScheduler = false;
+
+    auto poolLeafJob = [&](uintptr_t)
+    {
+        if (&JobScheduler::Current() != &pool)
+            wrongScheduler = true;
+
+        poolJobs.fetch_add(1);
+    };
+
+    // The free functions used inside a pool job operate on the pool
+    auto poolJob = [&](uintptr_t)
+    {
+        Counter childCounter = Counter(1);
+        KickJob(JOB(poolLeafJob, &childCounter, Priority::HIGH));
+        WaitForCounter(&childCounter);
+
+        poolLeafJob(0);
+    };
+
+    auto defaultJob = [&](uintptr_t)
+    {
+        if (&JobScheduler::Current() != &JobScheduler::Default())
+            wrongScheduler = true;
+
+        defaultJobs.fetch_add(1);
+    };
+
+    Counter poolCounter = Counter(jobCount);
+    Counter defaultCounter = Counter(jobCount);
+
+    for (int i = 0; i < jobCount; ++i)
+    {
+        pool.KickJob(JOB(poolJob, &poolCounter, Priority::NORMAL));
+        KickJob(JOB(defaultJob, &defaultCounter, Priority::NORMAL));
+    }
+
+    // The main thread parks on the default scheduler while the pool drains its own queues
+    WaitForCounter(&defaultCounter);
+    WaitForCounter(&poolCounter);
+
+    EXPECT_EQ(poolJobs.load(), jobCount * 2);
+    EXPECT_EQ(defaultJobs.load(), jobCount);
+    EXPECT_FALSE(wrongScheduler);
+
+    pool.Deinitialize();
+    EXPECT_FALSE(pool.IsInitialized());
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestElasticScaling)
+{
+    // The maximum amount of workers is clamped to the logical cores
+    if (std::thread::hardware_concurrency() < 2)
+        GTEST_SKIP() << "Elastic scaling needs at least two logical cores";
+
+    const int maxWorkers = std::min(3, (int)std::thread::hardware_concurrency());
+
+    JobSchedulerDesc desc{};
+    desc.m_NumOfThreads = 1;
+    desc.m_MaxNumOfThreads = 3;
+    desc.m_AdoptCallingThread = false;
+
+    // The test drives the scaling decisions with its own samples instead of the wall clock
+    desc.m_AutomaticScaling = false;
+
+    std::vector<ScalingEvent> events;
+    desc.m_ScalingCallback = [&](const ScalingEvent& scalingEvent) { events.push_back(scalingEvent); };
+
+    JobScheduler pool;
+    pool.Initialize(desc);
+    EXPECT_EQ(pool.GetNumWorkers(), 1);
+
+    // A backlog the workers need far longer than the growth threshold to drain
+    ScalingSample pressure{};
+    pressure.m_QueuedJobs = 2000;
+    pressure.m_AverageJobNs = 100000.0;
+    pressure.m_Utilization = 1.0;
+
+    for (int worker = 2; worker <= maxWorkers; ++worker)
+    {
+        for (int i = 1; i < WORKER_GROW_SAMPLES(); ++i)
+        {
+            EXPECT_FALSE(pool.UpdateScaling(pressure));
+        }
+
+        EXPECT_TRUE(pool.UpdateScaling(pressure));
+        EXPECT_EQ(pool.GetNumWorkers(), worker);
+    }
+
+    // Never beyond the maximum
+    for (int i = 0; i < WORKER_GROW_SAMPLES() * 2; ++i)
+    {
+        EXPECT_FALSE(pool.UpdateScaling(pressure));
+    }
+
+    EXPECT_EQ(pool.GetNumWorkers(), maxWorkers);
+
+    // The grown pool executes jobs
+    static constexpr int jobCount = 200;
+    std::atomic<int> executed = 0;
+    auto countingJob = [&](uintptr_t) { executed.fetch_add(1); };
+
+    Counter jobCounter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        pool.KickJob(JOB(countingJob, &jobCounter, Priority::NORMAL));
+    }
+
+    while (jobCounter.load() > 0)
+        std::this_thread::yield();
+
+    EXPECT_EQ(executed.load(), jobCount);
+
+    // After sustained idleness the pool shrinks back to its minimum, one worker per window
+    const ScalingSample idle{};
+
+    for (int worker = maxWorkers - 1; worker >= 1; --worker)
+    {
+        for (int i = 1; i < WORKER_RETIRE_SAMPLES(); ++i)
+        {
+            EXPECT_FALSE(pool.UpdateScaling(idle));
+        }
+
+        EXPECT_TRUE(pool.UpdateScaling(idle));
+        EXPECT_EQ(pool.GetNumWorkers(), worker);
+    }
+
+    EXPECT_FALSE(pool.UpdateScaling(idle));
+
+    pool.Deinitialize();
+
+    ASSERT_EQ(events.size(), (size_t)(maxWorkers - 1) * 2);
+    EXPECT_EQ(events.front().m_Action, ScalingAction::GROW);
+    EXPECT_EQ(events.front().m_NumWorkers, 2);
+    EXPECT_EQ(events.back().m_Action, ScalingAction::RETIRE);
+    EXPECT_EQ(events.back().m_NumWorkers, 1);
+}
+
+static void SpinFor(const std::chrono::microseconds duration)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < duration) { }
+}
+
+TEST(BorealisJobsTest, TestMainThreadStealing)
+{
+    InitializeJobSystem(1);
+
+    static constexpr int jobCount = 500;
+
+    const std::thread::id mainThreadId = std::this_thread::get_id();
+    std::atomic<int> mainThreadJobs = 0;
+
+    auto workerJob = [&](uintptr_t)
+    {
+        SpinFor(std::chrono::microseconds(50));
+
+        if (std::this_thread::get_id() == mainThreadId)
+            ++mainThreadJobs;
+    };
+
+    // The waiting main thread helps the single worker
+    Counter jobCounter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        KickJob(JOB(workerJob, &jobCounter, Priority::NORMAL));
+    }
+
+    WaitForCounter(&jobCounter);
+    EXPECT_GT(mainThreadJobs.load(), 0);
+
+    // Without a budget the main thread only waits
+    SetMainThreadStealBudget(std::chrono::microseconds(0));
+    mainThreadJobs = 0;
+
+    jobCounter = jobCount;
+    for (int i = 0; i < jobCount; ++i)
+    {
+        KickJob(JOB(workerJob, &jobCounter, Priority::NORMAL));
+    }
+
+    WaitForCounter(&jobCounter);
+    EXPECT_EQ(mainThreadJobs.load(), 0);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestMainThreadStealBudget)
+{
+    InitializeJobSystem(1);
+    SetMainThreadStealBudget(std::chrono::microseconds(200));
+
+    static constexpr int rounds = 20;
+    static constexpr int jobCount = 8;
+
+    const std::thread::id mainThreadId = std::this_thread::get_id();
+    std::atomic<int> mainThreadSlowJobs = 0;
+
+    auto slowJob = [&](uintptr_t)
+    {
+        SpinFor(std::chrono::microseconds(2000));
+
+        if (std::this_thread::get_id() == mainThreadId)
+            ++mainThreadSlowJobs;
+    };
+
+    // A slow job type is stolen at most once before the main thread stops taking it
+    for (int round = 0; round < rounds; ++round)
+    {
+        Counter jobCounter = Counter(jobCount);
+        for (int i = 0; i < jobCount; ++i)
+        {
+            KickJob(JOB(slowJob, &jobCounter, Priority::NORMAL));
+        }
+
+        WaitForCounter(&jobCounter);
+    }
+
+    EXPECT_LE(mainThreadSlowJobs.load(), 1);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestPriorityInheritance)
+{
+    InitializeJobSystem(1);
+    SetMainThreadStealBudget(std::chrono::microseconds(0));
+
+    static constexpr int loadCount = 400;
+
+    std::atomic<int> loadExecuted = 0;
+    std::atomic<int> loadExecutedBeforeChildren = loadCount;
+    std::atomic<int> childrenExecuted = 0;
+
+    auto loadJob = [&](uintptr_t)
+    {
+        SpinFor(std::chrono::microseconds(100));
+        loadExecuted.fetch_add(1);
+    };
+
+    auto childJob = [&](uintptr_t)
+    {
+        if (childrenExecuted.fetch_add(1) == 1)
+            loadExecutedBeforeChildren = loadExecuted.load();
+    };
+
+    // A high priority parent waits on low priority children, one kicked before it waits and one kicked while it waits
+    Counter children = Counter(2);
+    auto parentJob = [&](uintptr_t)
+    {
+        KickJob(JOB(childJob, &children, Priority::LOW));
+        WaitForCounter(&children);
+    };
+
+    Counter loadCounter = Counter(loadCount);
+    for (int i = 0; i < loadCount; ++i)
+    {
+        KickJob(JOB(loadJob, &loadCounter, Priority::NORMAL));
+    }
+
+    Counter parentCounter = Counter(1);
+    KickJob(JOB(parentJob, &parentCounter, Priority::HIGH));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    KickJob(JOB(childJob, &children, Priority::LOW));
+
+    WaitForCounter(&parentCounter);
+    WaitForCounter(&loadCounter);
+
+    // Without inheritance the children would only run once the normal priority backlog is drained
+    EXPECT_EQ(childrenExecuted.load(), 2);
+    EXPECT_LT(loadExecutedBeforeChildren.load(), loadCount);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestInheritanceForQueuedChildren)
+{
+    InitializeJobSystem(1);
+    SetMainThreadStealBudget(std::chrono::microseconds(0));
+
+    static constexpr int loadCount = 400;
+
+    std::atomic<int> loadExecuted = 0;
+    std::atomic<int> loadExecutedBeforeChild = -1;
+
+    auto loadJob = [&](uintptr_t)
+    {
+        SpinFor(std::chrono::microseconds(100));
+        loadExecuted.fetch_add(1);
+    };
+
+    auto childJob = [&](uintptr_t) { loadExecutedBeforeChild = loadExecuted.load(); };
+
+    Counter loadCounter = Counter(loadCount);
+    for (int i = 0; i < loadCount; ++i)
+    {
+        KickJob(JOB(loadJob, &loadCounter, Priority::NORMAL));
+    }
+
+    // The child is already queued when a high priority job starts waiting on it
+    Counter child = Counter(1);
+    KickJob(JOB(childJob, &child, Priority::LOW));
+
+    Counter waitingCounter = Counter(1);
+    auto waitingJob = [&](uintptr_t) { WaitForCounter(&child); };
+    KickJob(JOB(waitingJob, &waitingCounter, Priority::HIGH));
+
+    WaitForCounter(&waitingCounter);
+    WaitForCounter(&loadCounter);
+
+    EXPECT_LT(loadExecutedBeforeChild.load(), loadCount);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestCriticalJobs)
+{
+    InitializeJobSystem();
+
+    static constexpr int jobCount = 32;
+
+    std::atomic<int> executed = 0;
+    auto criticalJob = [&](uintptr_t) { executed.fetch_add(1); };
+
+    // Critical jobs share the high priority queue
+    Counter jobCounter = Counter(jobCount * 2);
+    KickJob(JOB(criticalJob, &jobCounter, Priority::CRITICAL));
+
+    std::vector<Job> jobs(jobCount * 2 - 1, JOB(criticalJob, &jobCounter, Priority::CRITICAL));
+    KickJobs(jobs.data(), (int)jobs.size());
+
+    WaitForCounter(&jobCounter);
+    EXPECT_EQ(executed.load(), jobCount * 2);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsTest, TestParkingJobHandsBatchBack)
+{
+    InitializeJobSystem(1);
+    SetMainThreadStealBudget(std::chrono::microseconds(0));
+
+    auto microJob = [](uintptr_t) {};
+
+    // Warm up the worker, so it takes the following jobs as a single batch
+    std::vector<Job> warmupJobs;
+    Counter warmupCounter = Counter(2000);
+    for (int i = 0; i < 2000; ++i)
+    {
+        warmupJobs.push_back(JOB(microJob, &warmupCounter, Priority::NORMAL));
+    }
+
+    KickJobs(warmupJobs.data(), (int)warmupJobs.size());
+    WaitForCounter(&warmupCounter);
+
+    static constexpr int rounds = 20;
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        JobEvent event;
+        Counter jobCounter = Counter(3);
+
+        // The waiter parks in front of the job setting its event within the same batch
+        auto waitingJob = [&](uintptr_t) { event.Wait(); };
+        auto settingJob = [&](uintptr_t) { event.Set(); };
+
+        // Kicked by the only worker, so nobody takes the jobs before they are both queued
+        auto kickingJob = [&](uintptr_t)
+        {
+            Job jobs[2] = { JOB(waitingJob, &jobCounter, Priority::NORMAL), JOB(settingJob, &jobCounter, Priority::NORMAL) };
+            KickJobs(jobs, 2);
+        };
+
+        KickJob(JOB(kickingJob, &jobCounter, Priority::NORMAL));
+        WaitForCounter(&jobCounter);
+
+        EXPECT_TRUE(event.IsSet());
+    }
+
+    DeinitializeJobSystem();
+}
+
+static thread_local bool t_isMainThread = false;
+
+// Never inlined, so a job resumed on another thread doesn't reuse a cached thread id
+static __declspec(noinline) bool IsMainThread()
+{
+    return t_isMainThread;
+}
+
+TEST(BorealisJobsTest, TestStolenJobResumesOnWorker)
+{
+    InitializeJobSystem(1);
+    SetMainThreadStealBudget(std::chrono::microseconds(1000));
+
+    static constexpr int parentCount = 8;
+
+    t_isMainThread = true;
+    std::atomic<bool> blockerStarted = false;
+    std::atomic<int> stolenParents = 0;
+    std::atomic<int> resumedOnMain = 0;
+
+    Counter gate = Counter(1);
+    Counter release = Counter(1);
+    Counter children = Counter(parentCount);
+    Counter parentCounter = Counter(parentCount);
+    Counter blockerCounter = Counter(1);
+
+    // Occupies the only worker until the main thread stole a parent
+    auto blockerJob = [&](uintptr_t)
+    {
+        blockerStarted = true;
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        while (stolenParents.load() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+            std::this_thread::yield();
+    };
+
+    auto childJob = [&](uintptr_t) { WaitForCounter(&gate); };
+
+    auto parentJob = [&](uintptr_t)
+    {
+        KickJob(JOB(childJob, &children, Priority::NORMAL));
+
+        if (IsMainThread() && stolenParents.fetch_add(1) == 0)
+            release.fetch_sub(1);
+
+        WaitForCounter(&children);
+
+        if (IsMainThread())
+            ++resumedOnMain;
+    };
+
+    KickJob(JOB(blockerJob, &blockerCounter, Priority::NORMAL));
+    while (!blockerStarted.load())
+        std::this_thread::yield();
+
+    for (int i = 0; i < parentCount; ++i)
+    {
+        KickJob(JOB(parentJob, &parentCounter, Priority::NORMAL));
+    }
+
+    // Stops waiting once the first stolen parent parked on its children
+    WaitForCounter(&release);
+    gate.fetch_sub(1);
+
+    // Poll instead of waiting, so the main thread can't resume the parents itself
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (parentCounter.load() > 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+        std::this_thread::yield();
+
+    const bool finishedByWorker = parentCounter.load() == 0;
+
+    WaitForCounter(&parentCounter);
+    WaitForCounter(&blockerCounter);
+
+    EXPECT_GT(stolenParents.load(), 0);
+    EXPECT_TRUE(finishedByWorker);
+    EXPECT_EQ(resumedOnMain.load(), 0);
+
+    t_isMainThread = false;
+    DeinitializeJobSystem();
 }
 
 #endif
\ No newline at end of file
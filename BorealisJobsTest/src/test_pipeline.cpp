@@ -0,0 +1,219 @@
+#include <vector>
+#include <atomic>
+
+#include <gtest/gtest.h>
+#include "../../src/job-system.h"
+#include "../../src/job-pipeline.h"
+#include "../../src/job-cost-model.h"
+
+#ifdef BOREALIS_WIN
+
+using namespace Borealis::Jobs;
+
+static constexpr int itemCount = 2000;
+
+// Source producing the values [0, itemCount) as heap allocated items
+static PipelineSource MakeCountingSource(int& next)
+{
+    return [&next](void*& item)
+    {
+        if (next >= itemCount)
+            return false;
+
+        item = new int(next++);
+        return true;
+    };
+}
+
+TEST(BorealisJobsPipelineTest, TestSerialInOrderOutput)
+{
+    InitializeJobSystem();
+
+    int next = 0;
+    std::vector<int> output;
+
+    Pipeline pipeline(8);
+    pipeline.SetSource(MakeCountingSource(next))
+        .AddStage(StageMode::PARALLEL, [](void* item)
+        {
+            // Uneven work, so the tokens overtake each other
+            volatile int spin = 0;
+            for (int i = 0; i < (*(int*)item % 7) * 200; ++i)
+                spin = spin + i;
+
+            *(int*)item *= 2;
+            return item;
+        })
+        .AddStage(StageMode::SERIAL_IN_ORDER, [&output](void* item)
+        {
+            output.push_back(*(int*)item);
+            delete (int*)item;
+            return (void*)nullptr;
+        });
+
+    pipeline.Run();
+
+    ASSERT_EQ(output.size(), (size_t)itemCount);
+    for (int i = 0; i < itemCount; ++i)
+    {
+        EXPECT_EQ(output[i], i * 2);
+    }
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsPipelineTest, TestSerialOutOfOrderExclusion)
+{
+    InitializeJobSystem();
+
+    int next = 0;
+    int processed = 0;
+    std::atomic<int> owners = 0;
+    std::atomic<bool> overlapped = false;
+
+    Pipeline pipeline(8);
+    pipeline.SetSource(MakeCountingSource(next))
+        .AddStage(StageMode::SERIAL_OUT_OF_ORDER, [&](void* item)
+        {
+            if (owners.fetch_add(1) != 0)
+                overlapped = true;
+
+            ++processed;
+            owners.fetch_sub(1);
+
+            delete (int*)item;
+            return (void*)nullptr;
+        });
+
+    pipeline.Run();
+
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_EQ(processed, itemCount);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsPipelineTest, TestTokenLimit)
+{
+    InitializeJobSystem();
+
+    static constexpr int maxTokens = 3;
+
+    int next = 0;
+    std::atomic<int> inFlight = 0;
+    std::atomic<int> maxInFlight = 0;
+
+    Pipeline pipeline(maxTokens);
+    pipeline.SetSource([&](void*& item)
+        {
+            if (next >= itemCount)
+                return false;
+
+            // Counted at the source, so every allocated item is covered
+            const int current = inFlight.fetch_add(1) + 1;
+            int observed = maxInFlight.load();
+            while (current > observed && !maxInFlight.compare_exchange_weak(observed, current)) {}
+
+            item = new int(next++);
+            return true;
+        })
+        .AddStage(StageMode::PARALLEL, [](void* item)
+        {
+            volatile int spin = 0;
+            for (int i = 0; i < 1000; ++i)
+                spin = spin + i;
+
+            return item;
+        })
+        .AddStage(StageMode::PARALLEL, [&](void* item)
+        {
+            delete (int*)item;
+            inFlight.fetch_sub(1);
+            return (void*)nullptr;
+        });
+
+    pipeline.Run();
+
+    EXPECT_EQ(inFlight.load(), 0);
+    EXPECT_LE(maxInFlight.load(), maxTokens);
+    EXPECT_GE(maxInFlight.load(), 1);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsPipelineTest, TestTokenPriorityAndName)
+{
+    InitializeJobSystem();
+    ResetJobCosts();
+
+    int next = 0;
+    int processed = 0;
+
+    // Token costs are learned under the pipeline's own name rather than the shared default
+    Pipeline pipeline(4, Priority::HIGH, "HighPriorityPipelineToken");
+    pipeline.SetSource(MakeCountingSource(next))
+        .AddStage(StageMode::SERIAL_IN_ORDER, [&](void* item)
+        {
+            delete (int*)item;
+            ++processed;
+            return (void*)nullptr;
+        });
+
+    pipeline.Run();
+
+    EXPECT_EQ(processed, itemCount);
+
+    double estimateNs = 0.0;
+    EXPECT_TRUE(GetJobCostEstimate("HighPriorityPipelineToken", estimateNs));
+    EXPECT_FALSE(GetJobCostEstimate("PipelineToken", estimateNs));
+
+    ResetJobCosts();
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsPipelineTest, TestFilteredItems)
+{
+    InitializeJobSystem();
+
+    int next = 0;
+    std::vector<int> output;
+
+    Pipeline pipeline(6);
+    pipeline.SetSource(MakeCountingSource(next))
+        .AddStage(StageMode::PARALLEL, [](void* item)
+        {
+            // Drop the odd values
+            if (*(int*)item % 2 != 0)
+            {
+                delete (int*)item;
+                return (void*)nullptr;
+            }
+
+            return item;
+        })
+        .AddStage(StageMode::SERIAL_IN_ORDER, [&output](void* item)
+        {
+            output.push_back(*(int*)item);
+            delete (int*)item;
+            return (void*)nullptr;
+        });
+
+    pipeline.Run();
+
+    ASSERT_EQ(output.size(), (size_t)itemCount / 2);
+    for (int i = 0; i < itemCount / 2; ++i)
+    {
+        EXPECT_EQ(output[i], i * 2);
+    }
+
+    // The pipeline can be run again once the source is refilled
+    next = itemCount - 10;
+    output.clear();
+    pipeline.Run();
+
+    EXPECT_EQ(output.size(), (size_t)5);
+
+    DeinitializeJobSystem();
+}
+
+#endif
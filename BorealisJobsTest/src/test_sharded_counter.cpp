@@ -0,0 +1,108 @@
+#include <vector>
+#include <atomic>
+
+#include <gtest/gtest.h>
+#include "../../src/job-system.h"
+#include "../../src/sharded-counter.h"
+
+#ifdef BOREALIS_WIN
+
+using namespace Borealis::Jobs;
+
+TEST(BorealisJobsShardedCounterTest, TestCountDistribution)
+{
+    ShardedCounter counter(0);
+    EXPECT_TRUE(counter.IsDone());
+    EXPECT_EQ(counter.GetCount(), 0);
+    EXPECT_EQ(counter.GetRoot()->load(), 0);
+
+    // Fewer children than shards leaves some shards empty, which the root must not wait for
+    counter.Reset(1);
+    EXPECT_FALSE(counter.IsDone());
+    EXPECT_EQ(counter.GetRoot()->load(), 1);
+
+    const int count = counter.GetNumShards() * 3 + 1;
+    counter.Reset(count);
+    EXPECT_EQ(counter.GetCount(), count);
+    EXPECT_EQ(counter.GetRoot()->load(), counter.GetNumShards());
+
+    // A single thread drains its own shard first and all the others afterwards
+    for (int i = 0; i < count - 1; ++i)
+    {
+        counter.Decrement();
+        EXPECT_FALSE(counter.IsDone());
+    }
+
+    EXPECT_EQ(counter.GetCount(), 1);
+    counter.Decrement();
+    EXPECT_TRUE(counter.IsDone());
+    EXPECT_EQ(counter.GetCount(), 0);
+}
+
+TEST(BorealisJobsShardedCounterTest, TestWideFanIn)
+{
+    InitializeJobSystem();
+
+    static constexpr int childCount = 100000;
+    static constexpr int rounds = 3;
+
+    std::atomic<int> executed = 0;
+    auto childJob = [&](uintptr_t) { executed.fetch_add(1, std::memory_order_relaxed); };
+
+    ShardedCounter counter(0);
+    std::vector<Job> jobs(childCount, JOB(childJob, counter, Priority::NORMAL));
+
+    // The counter is reused for every fan-out
+    for (int r = 1; r <= rounds; ++r)
+    {
+        counter.Reset(childCount);
+        KickJobs(jobs.data(), childCount);
+        WaitForCounter(counter);
+
+        EXPECT_TRUE(counter.IsDone());
+        EXPECT_EQ(counter.GetCount(), 0);
+        EXPECT_EQ(executed.load(), childCount * r);
+    }
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsShardedCounterTest, TestWaitFromJob)
+{
+    InitializeJobSystem();
+
+    static constexpr int parentCount = 8;
+    static constexpr int childCount = 2000;
+
+    std::atomic<int> executed = 0;
+    std::atomic<int> resumed = 0;
+
+    auto childJob = [&](uintptr_t) { executed.fetch_add(1, std::memory_order_relaxed); };
+
+    // Parents park their fibers on a sharded counter instead of the main thread
+    auto parentJob = [&](uintptr_t)
+    {
+        ShardedCounter counter(childCount);
+        std::vector<Job> jobs(childCount, JOB(childJob, counter, Priority::HIGH));
+
+        KickJobs(jobs.data(), childCount);
+        WaitForCounter(counter);
+
+        EXPECT_EQ(counter.GetCount(), 0);
+        resumed.fetch_add(1);
+    };
+
+    Counter parentCounter = Counter(parentCount);
+    for (int i = 0; i < parentCount; ++i)
+    {
+        KickJob(JOB(parentJob, &parentCounter, Priority::NORMAL));
+    }
+    WaitForCounter(&parentCounter);
+
+    EXPECT_EQ(resumed.load(), parentCount);
+    EXPECT_EQ(executed.load(), parentCount * childCount);
+
+    DeinitializeJobSystem();
+}
+
+#endif
@@ -0,0 +1,219 @@
+#include <vector>
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "../../src/job-system.h"
+#include "../../src/job-sync.h"
+#include "../../src/scoped-spinlock.h"
+
+#ifdef BOREALIS_WIN
+
+using namespace Borealis::Jobs;
+
+template<typename LockType>
+static void RunSpinLockContention()
+{
+    static constexpr int threadCount = 4;
+    static constexpr int iterations = 20000;
+
+    LockType lock{};
+    int sharedValue = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                ScopedSpinLock scopedLock(lock);
+                ++sharedValue;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(sharedValue, threadCount * iterations);
+
+    EXPECT_TRUE(lock.TryAcquire());
+    EXPECT_FALSE(lock.TryAcquire());
+    lock.Release();
+}
+
+TEST(BorealisJobsSyncTest, TestSpinLock)
+{
+    RunSpinLockContention<SpinLock>();
+}
+
+TEST(BorealisJobsSyncTest, TestTicketSpinLock)
+{
+    RunSpinLockContention<TicketSpinLock>();
+}
+
+TEST(BorealisJobsSyncTest, TestMutexExclusion)
+{
+    InitializeJobSystem();
+
+    static constexpr int jobCount = 32;
+    static constexpr int iterations = 1000;
+
+    JobMutex mutex;
+    int sharedValue = 0;
+    std::atomic<int> owners = 0;
+    std::atomic<bool> overlapped = false;
+
+    auto lockJob = [&](uintptr_t)
+    {
+        for (int i = 0; i < iterations; ++i)
+        {
+            ScopedJobLock lock(mutex);
+
+            if (owners.fetch_add(1) != 0)
+                overlapped = true;
+
+            ++sharedValue;
+            owners.fetch_sub(1);
+        }
+    };
+
+    Counter jobCounter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        KickJob(JOB(lockJob, &jobCounter, Priority::NORMAL));
+    }
+    WaitForCounter(&jobCounter);
+
+    EXPECT_FALSE(overlapped);
+    EXPECT_EQ(sharedValue, jobCount * iterations);
+    EXPECT_EQ(jobCounter, 0);
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsSyncTest, TestMutexHeldAcrossWait)
+{
+    InitializeJobSystem();
+
+    // The owner suspends while holding the mutex. Contenders must park their fibers instead of
+    // blocking the workers, otherwise the child job could never run.
+    static constexpr int jobCount = 8;
+
+    JobMutex mutex;
+    int sharedValue = 0;
+
+    auto childJob = [&](uintptr_t)
+    {
+        ++sharedValue;
+    };
+
+    auto lockJob = [&](uintptr_t)
+    {
+        ScopedJobLock lock(mutex);
+
+        Counter childCounter = Counter(1);
+        KickJob(JOB(childJob, &childCounter, Priority::HIGH));
+        WaitForCounter(&childCounter);
+    };
+
+    Counter jobCounter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        KickJob(JOB(lockJob, &jobCounter, Priority::NORMAL));
+    }
+    WaitForCounter(&jobCounter);
+
+    EXPECT_EQ(sharedValue, jobCount);
+    EXPECT_TRUE(mutex.TryLock());
+    mutex.Unlock();
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsSyncTest, TestSemaphoreLimitsConcurrency)
+{
+    InitializeJobSystem();
+
+    static constexpr int jobCount = 16;
+    static constexpr int permits = 2;
+
+    JobSemaphore semaphore(permits);
+    std::atomic<int> active = 0;
+    std::atomic<int> maxActive = 0;
+
+    auto childJob = [](uintptr_t) { };
+
+    auto limitedJob = [&](uintptr_t)
+    {
+        semaphore.Acquire();
+
+        const int nowActive = active.fetch_add(1) + 1;
+        int expected = maxActive.load();
+        while (nowActive > expected && !maxActive.compare_exchange_weak(expected, nowActive)) { }
+
+        // Suspend while holding the permit
+        Counter childCounter = Counter(1);
+        KickJob(JOB(childJob, &childCounter, Priority::HIGH));
+        WaitForCounter(&childCounter);
+
+        active.fetch_sub(1);
+        semaphore.Release();
+    };
+
+    Counter jobCounter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        KickJob(JOB(limitedJob, &jobCounter, Priority::NORMAL));
+    }
+    WaitForCounter(&jobCounter);
+
+    EXPECT_LE(maxActive.load(), permits);
+    EXPECT_GE(maxActive.load(), 1);
+    EXPECT_TRUE(semaphore.TryAcquire());
+    EXPECT_TRUE(semaphore.TryAcquire());
+    EXPECT_FALSE(semaphore.TryAcquire());
+
+    DeinitializeJobSystem();
+}
+
+TEST(BorealisJobsSyncTest, TestEventReleasesAllWaiters)
+{
+    InitializeJobSystem();
+
+    static constexpr int jobCount = 8;
+
+    JobEvent event;
+    std::atomic<int> released = 0;
+
+    auto waitingJob = [&](uintptr_t)
+    {
+        event.Wait();
+        released.fetch_add(1);
+    };
+
+    Counter jobCounter = Counter(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+    {
+        KickJob(JOB(waitingJob, &jobCounter, Priority::NORMAL));
+    }
+
+    EXPECT_FALSE(event.IsSet());
+    EXPECT_EQ(released.load(), 0);
+
+    event.Set();
+    WaitForCounter(&jobCounter);
+
+    EXPECT_TRUE(event.IsSet());
+    EXPECT_EQ(released.load(), jobCount);
+
+    event.Reset();
+    EXPECT_FALSE(event.IsSet());
+
+    DeinitializeJobSystem();
+}
+
+#endif